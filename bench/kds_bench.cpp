@@ -0,0 +1,1265 @@
+// Benchmarks static_vector against std::vector, std::array and, when its
+// header is available, boost::container::static_vector, as well as the
+// specialized containers against the static_vector they stand in for, and
+// prints the results as JSON. Build and run from the repository root with
+//
+//     cmake -S . -B build -DCMAKE_BUILD_TYPE=Release
+//     cmake --build build --target kds_bench
+//     ./build/kds_bench [filter] > results.json
+//
+// where filter keeps the benchmarks whose "op/container/type/n" name
+// contains it. On Linux the instructions and cache misses of every
+// benchmark are read through perf_event_open when the kernel allows it
+// (see /proc/sys/kernel/perf_event_paranoid); otherwise they are null.
+
+#include "mpmc_queue.h"
+#include "small_vector.h"
+#include "spsc_queue.h"
+#include "static_bitvector.h"
+#include "static_deque.h"
+#include "static_flat_map.h"
+#include "static_flat_set.h"
+#include "static_packed_vector.h"
+#include "static_priority_queue.h"
+#include "static_search_index.h"
+#include "static_soa_vector.h"
+#include "static_unordered_map.h"
+#include "static_vector.h"
+#include "static_vector_algorithm.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if __has_include(<boost/container/static_vector.hpp>)
+#include <boost/container/static_vector.hpp>
+#define KDS_BENCH_BOOST 1
+#endif
+
+#if __has_include(<flat_map>) && __has_include(<flat_set>)
+#include <flat_map>
+#include <flat_set>
+#endif
+#if defined(__cpp_lib_flat_map) && defined(__cpp_lib_flat_set)
+#define KDS_BENCH_STD_FLAT 1
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+    // keeps the compiler from dropping the work that produced value
+    template<typename T>
+    void do_not_optimize(const T &value)
+    {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    struct counts
+    {
+        std::optional<std::uint64_t> instructions;
+        std::optional<std::uint64_t> cache_misses;
+    };
+
+    // instruction and cache miss counters of the calling thread, read as one group
+    class perf_counters
+    {
+    public:
+        perf_counters()
+        {
+#if defined(__linux__)
+            instructions_fd = open_counter(PERF_COUNT_HW_INSTRUCTIONS, -1);
+            if (instructions_fd >= 0)
+                cache_misses_fd = open_counter(PERF_COUNT_HW_CACHE_MISSES, instructions_fd);
+#endif
+        }
+
+        perf_counters(const perf_counters &) = delete;
+
+        perf_counters &operator=(const perf_counters &) = delete;
+
+        ~perf_counters()
+        {
+#if defined(__linux__)
+            if (cache_misses_fd >= 0)
+                close(cache_misses_fd);
+            if (instructions_fd >= 0)
+                close(instructions_fd);
+#endif
+        }
+
+        [[nodiscard]] bool available() const noexcept { return instructions_fd >= 0; }
+
+        void start() noexcept
+        {
+#if defined(__linux__)
+            if (!available())
+                return;
+            ioctl(instructions_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(instructions_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        counts stop() noexcept
+        {
+            counts result;
+#if defined(__linux__)
+            if (!available())
+                return result;
+            ioctl(instructions_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            struct
+            {
+                std::uint64_t nr;
+                std::uint64_t values[2];
+            } group{};
+            if (read(instructions_fd, &group, sizeof(group)) <= 0)
+                return result;
+            if (group.nr >= 1)
+                result.instructions = group.values[0];
+            if (group.nr >= 2)
+                result.cache_misses = group.values[1];
+#endif
+            return result;
+        }
+
+    private:
+        int instructions_fd{-1};
+        int cache_misses_fd{-1};
+
+#if defined(__linux__)
+        static int open_counter(std::uint64_t config, int group_fd) noexcept
+        {
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.disabled = group_fd < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+        }
+#endif
+    };
+
+    struct result
+    {
+        std::string name;
+        double ns_per_op;
+        std::optional<double> instructions_per_op;
+        std::optional<double> cache_misses_per_op;
+    };
+
+    class runner
+    {
+    public:
+        explicit runner(std::string_view name_filter) : filter(name_filter) {}
+
+        // times body, which performs ops operations per call: the call count
+        // is doubled until a sample takes min_sample, then the fastest of
+        // several samples is kept together with its counter readings
+        template<typename Body>
+        void run(const std::string &name, std::size_t ops, Body body)
+        {
+            if (name.find(filter) == std::string::npos)
+                return;
+
+            std::size_t calls{1};
+            while (time(body, calls) < min_sample)
+                calls *= 2;
+
+            result best{name, 0.0, std::nullopt, std::nullopt};
+            for (int sample{0}; sample < samples; ++sample)
+            {
+                counters.start();
+                const double ns{time(body, calls)};
+                const counts counted{counters.stop()};
+                const double per_op{ns / static_cast<double>(calls * ops)};
+                if (sample == 0 || per_op < best.ns_per_op)
+                {
+                    best.ns_per_op = per_op;
+                    best.instructions_per_op = per_op_count(counted.instructions, calls * ops);
+                    best.cache_misses_per_op = per_op_count(counted.cache_misses, calls * ops);
+                }
+            }
+            results.push_back(std::move(best));
+        }
+
+        void print_json() const
+        {
+            std::printf("{\n  \"perf_counters\": %s,\n  \"benchmarks\": [", counters.available() ? "true" : "false");
+            for (std::size_t i{0}; i < results.size(); ++i)
+            {
+                const result &res{results[i]};
+                std::printf("%s\n    {\"name\": \"%s\", \"ns_per_op\": %.4f, \"instructions_per_op\": ", i == 0 ? "" : ",", res.name.c_str(), res.ns_per_op);
+                print_optional(res.instructions_per_op);
+                std::printf(", \"cache_misses_per_op\": ");
+                print_optional(res.cache_misses_per_op);
+                std::printf("}");
+            }
+            std::printf("\n  ]\n}\n");
+        }
+
+    private:
+        static constexpr double min_sample{20e6};// ns
+        static constexpr int samples{5};
+
+        std::string filter;
+        perf_counters counters;
+        std::vector<result> results;
+
+        template<typename Body>
+        static double time(Body &body, std::size_t calls)
+        {
+            const auto start{std::chrono::steady_clock::now()};
+            for (std::size_t i{0}; i < calls; ++i)
+                body();
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        static std::optional<double> per_op_count(std::optional<std::uint64_t> count, std::size_t ops)
+        {
+            if (!count)
+                return std::nullopt;
+            return static_cast<double>(*count) / static_cast<double>(ops);
+        }
+
+        static void print_optional(std::optional<double> value)
+        {
+            if (value)
+                std::printf("%.4f", *value);
+            else
+                std::printf("null");
+        }
+    };
+
+    // xorshift64, deterministic input shared by the benchmarks that need random data
+    std::uint64_t next_random(std::uint64_t &state)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // element values, the strings are too long for the small string buffer
+    template<typename T>
+    T make_value(std::size_t i)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::string(24, static_cast<char>('a' + i % 26));
+        else
+            return static_cast<T>(i);
+    }
+
+    template<typename T>
+    std::size_t weight(const T &value)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return value.size();
+        else
+            return static_cast<std::size_t>(value);
+    }
+
+    // row of the column benchmarks, 24 bytes of which a column pass reads 4
+    struct quote
+    {
+        double price;
+        std::int64_t id;
+        std::int32_t volume;
+        std::int32_t venue;
+    };
+
+    // pins the calling thread to the idx-th cpu it may run on, modulo their
+    // number, and restores its previous affinity on destruction; does
+    // nothing where affinity cannot be set
+    class cpu_pin
+    {
+    public:
+        explicit cpu_pin(std::size_t idx) noexcept
+        {
+#if defined(__linux__)
+            if (pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) != 0)
+                return;
+            const auto allowed{static_cast<std::size_t>(CPU_COUNT(&previous))};
+            for (std::size_t cpu{0}, seen{0}; allowed > 0 && cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &previous) && seen++ == idx % allowed)
+                {
+                    cpu_set_t set;
+                    CPU_ZERO(&set);
+                    CPU_SET(cpu, &set);
+                    pinned = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+                    break;
+                }
+#else
+            static_cast<void>(idx);
+#endif
+        }
+
+        cpu_pin(const cpu_pin &) = delete;
+
+        cpu_pin &operator=(const cpu_pin &) = delete;
+
+        ~cpu_pin()
+        {
+#if defined(__linux__)
+            if (pinned)
+                pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+#endif
+        }
+
+    private:
+#if defined(__linux__)
+        cpu_set_t previous{};
+#endif
+        bool pinned{false};
+    };
+
+    // step of a spin wait: a pause, and now and then a yield so that more
+    // threads than cpus still make progress
+    class backoff
+    {
+    public:
+        void operator()() noexcept
+        {
+            if (++spins % 64 == 0)
+                std::this_thread::yield();
+            else
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#endif
+            }
+        }
+
+    private:
+        unsigned spins{0};
+    };
+
+    // threads, each pinned to its own cpu where there are enough, that run
+    // a job together with the calling thread, which takes index 0; they
+    // persist across jobs so that a benchmark does not time thread creation
+    class thread_team
+    {
+    public:
+        using job = std::function<void(std::size_t)>;
+
+        explicit thread_team(std::size_t size) : pin(0)
+        {
+            for (std::size_t idx{1}; idx < size; ++idx)
+                workers.emplace_back([this, idx] { work(idx); });
+        }
+
+        thread_team(const thread_team &) = delete;
+
+        thread_team &operator=(const thread_team &) = delete;
+
+        ~thread_team()
+        {
+            stopping = true;
+            generation.fetch_add(1, std::memory_order_release);
+            generation.notify_all();
+            for (std::thread &worker : workers)
+                worker.join();
+        }
+
+        // runs body(idx) on every thread of the team and returns once all are done
+        void run(const job &body)
+        {
+            current = &body;
+            pending.store(workers.size(), std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            generation.notify_all();
+            body(0);
+            backoff wait;
+            while (pending.load(std::memory_order_acquire) != 0)
+                wait();
+        }
+
+    private:
+        cpu_pin pin;
+        std::vector<std::thread> workers;
+        const job *current{nullptr};
+        std::atomic<std::uint64_t> generation{0};
+        std::atomic<std::size_t> pending{0};
+        bool stopping{false};// written before, read after a generation change
+
+        void work(std::size_t idx)
+        {
+            cpu_pin pinned{idx};
+            std::uint64_t seen{0};
+            for (;;)
+            {
+                generation.wait(seen, std::memory_order_acquire);
+                seen = generation.load(std::memory_order_acquire);
+                if (stopping)
+                    return;
+                (*current)(idx);
+                pending.fetch_sub(1, std::memory_order_release);
+            }
+        }
+    };
+
+    // the mutex-guarded ring buffer that the lock-free queues replace
+    template<typename T, std::size_t N>
+    class mutex_queue
+    {
+    public:
+        bool try_push(const T &value)
+        {
+            const std::lock_guard lock{mutex};
+            if (ring.full())
+                return false;
+            ring.push_back(value);
+            return true;
+        }
+
+        bool try_pop(T &out)
+        {
+            const std::lock_guard lock{mutex};
+            if (ring.empty())
+                return false;
+            out = std::move(ring.front());
+            ring.pop_front();
+            return true;
+        }
+
+    private:
+        std::mutex mutex;
+        ksv::static_deque<T, N> ring;
+    };
+
+    template<typename T>
+    constexpr std::string_view type_name()
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return "string";
+        else if constexpr (std::is_same_v<T, bool>)
+            return "bool";
+        else if constexpr (std::is_same_v<T, quote>)
+            return "quote";
+        else if constexpr (std::is_same_v<T, double>)
+            return "double";
+        else
+            return "int";
+    }
+
+    template<typename T, std::size_t N>
+    std::string bench_name(std::string_view op, std::string_view container)
+    {
+        std::string name{op};
+        name.append("/").append(container).append("/").append(type_name<T>()).append("/").append(std::to_string(N));
+        return name;
+    }
+
+    // containers growing up to N elements: std::vector keeps its capacity
+    // across clear() so only the element work is measured
+    template<typename C, typename T, std::size_t N>
+    void bench_sequence(runner &bench, std::string_view container)
+    {
+        std::vector<T> source;
+        for (std::size_t i{0}; i < N; ++i)
+            source.push_back(make_value<T>(i));
+
+        C filled;
+        if constexpr (requires { filled.reserve(N); })
+            filled.reserve(N);
+        for (const T &value : source)
+            filled.push_back(value);
+
+        C target{filled};
+        bench.run(bench_name<T, N>("push_back", container), N, [&] {
+            target.clear();
+            for (const T &value : source)
+                target.push_back(value);
+            do_not_optimize(target);
+        });
+
+        bench.run(bench_name<T, N>("emplace_back", container), N, [&] {
+            target.clear();
+            for (std::size_t i{0}; i < N; ++i)
+            {
+                if constexpr (std::is_same_v<T, std::string>)
+                    target.emplace_back(std::size_t{24}, static_cast<char>('a' + i % 26));
+                else
+                    target.emplace_back(static_cast<T>(i));
+            }
+            do_not_optimize(target);
+        });
+
+        bench.run(bench_name<T, N>("copy", container), N, [&] {
+            C copy{filled};
+            do_not_optimize(copy);
+        });
+
+        C moving{filled};
+        bench.run(bench_name<T, N>("move", container), 2 * N, [&] {
+            C moved{std::move(moving)};
+            do_not_optimize(moved);
+            moving = std::move(moved);
+            do_not_optimize(moving);
+        });
+
+        C other{filled};
+        bench.run(bench_name<T, N>("swap", container), N, [&] {
+            using std::swap;
+            swap(other, target);
+            do_not_optimize(other);
+        });
+
+        bench.run(bench_name<T, N>("iteration", container), N, [&] {
+            std::size_t sum{0};
+            for (const T &value : filled)
+                sum += weight(value);
+            do_not_optimize(sum);
+        });
+
+        const C equal{filled};
+        bench.run(bench_name<T, N>("comparison", container), N, [&] {
+            const bool same{filled == equal};
+            do_not_optimize(same);
+        });
+
+        bench.run(bench_name<T, N>("ordering", container), N, [&] {
+            const bool less{filled < equal};
+            do_not_optimize(less);
+        });
+
+        bench.run(bench_name<T, N>("range_construction", container), N, [&] {
+            C built(source.begin(), source.end());
+            do_not_optimize(built);
+        });
+    }
+
+    // std::array has a fixed size, so only the operations it supports
+    template<typename T, std::size_t N>
+    void bench_array(runner &bench)
+    {
+        std::array<T, N> filled;
+        for (std::size_t i{0}; i < N; ++i)
+            filled[i] = make_value<T>(i);
+
+        bench.run(bench_name<T, N>("copy", "std::array"), N, [&] {
+            std::array<T, N> copy{filled};
+            do_not_optimize(copy);
+        });
+
+        std::array<T, N> moving{filled};
+        bench.run(bench_name<T, N>("move", "std::array"), 2 * N, [&] {
+            std::array<T, N> moved{std::move(moving)};
+            do_not_optimize(moved);
+            moving = std::move(moved);
+            do_not_optimize(moving);
+        });
+
+        std::array<T, N> other{filled};
+        std::array<T, N> target{filled};
+        bench.run(bench_name<T, N>("swap", "std::array"), N, [&] {
+            using std::swap;
+            swap(other, target);
+            do_not_optimize(other);
+        });
+
+        bench.run(bench_name<T, N>("iteration", "std::array"), N, [&] {
+            std::size_t sum{0};
+            for (const T &value : filled)
+                sum += weight(value);
+            do_not_optimize(sum);
+        });
+
+        const std::array<T, N> equal{filled};
+        bench.run(bench_name<T, N>("comparison", "std::array"), N, [&] {
+            const bool same{filled == equal};
+            do_not_optimize(same);
+        });
+
+        bench.run(bench_name<T, N>("ordering", "std::array"), N, [&] {
+            const bool less{filled < equal};
+            do_not_optimize(less);
+        });
+    }
+
+    // size of the intersection of two flag sets, packed into words against one byte per flag
+    template<std::size_t N>
+    void bench_flags(runner &bench)
+    {
+        ksv::static_bitvector<N> lhs_bits;
+        ksv::static_bitvector<N> rhs_bits;
+        ksv::static_vector<bool, N> lhs_bytes;
+        ksv::static_vector<bool, N> rhs_bytes;
+        for (std::size_t i{0}; i < N; ++i)
+        {
+            lhs_bits.push_back(i % 3 == 0);
+            rhs_bits.push_back(i % 5 == 0);
+            lhs_bytes.push_back(i % 3 == 0);
+            rhs_bytes.push_back(i % 5 == 0);
+        }
+
+        bench.run(bench_name<bool, N>("intersection", "ksv::static_bitvector"), N, [&] {
+            const std::size_t common{(lhs_bits & rhs_bits).count()};
+            do_not_optimize(common);
+        });
+
+        bench.run(bench_name<bool, N>("intersection", "ksv::static_vector"), N, [&] {
+            std::size_t common{0};
+            for (std::size_t i{0}; i < N; ++i)
+                common += lhs_bytes[i] & rhs_bytes[i];
+            do_not_optimize(common);
+        });
+    }
+
+    // passes over one or two fields of N rows, stored as one array per field
+    // against an array of structs
+    template<std::size_t N>
+    void bench_columns(runner &bench)
+    {
+        ksv::static_soa_vector<N, double, std::int64_t, std::int32_t, std::int32_t> columns;
+        ksv::static_vector<quote, N> rows;
+        for (std::size_t i{0}; i < N; ++i)
+        {
+            const quote row{static_cast<double>(i % 97), static_cast<std::int64_t>(i), static_cast<std::int32_t>(i % 13), static_cast<std::int32_t>(i % 4)};
+            columns.emplace_back(row.price, row.id, row.volume, row.venue);
+            rows.push_back(row);
+        }
+
+        bench.run(bench_name<quote, N>("column_sum", "ksv::static_soa_vector"), N, [&] {
+            std::int64_t sum{0};
+            for (const std::int32_t volume : columns.template column<2>())
+                sum += volume;
+            do_not_optimize(sum);
+        });
+
+        bench.run(bench_name<quote, N>("column_sum", "ksv::static_vector"), N, [&] {
+            std::int64_t sum{0};
+            for (const quote &row : rows)
+                sum += row.volume;
+            do_not_optimize(sum);
+        });
+
+        bench.run(bench_name<quote, N>("filter", "ksv::static_soa_vector"), N, [&] {
+            const auto prices{columns.template column<0>()};
+            const auto volumes{columns.template column<2>()};
+            std::int64_t total{0};
+            for (std::size_t i{0}; i < prices.size(); ++i)
+                total += prices[i] > 48.0 ? volumes[i] : 0;
+            do_not_optimize(total);
+        });
+
+        bench.run(bench_name<quote, N>("filter", "ksv::static_vector"), N, [&] {
+            std::int64_t total{0};
+            for (const quote &row : rows)
+                total += row.price > 48.0 ? row.volume : 0;
+            do_not_optimize(total);
+        });
+    }
+
+    // 20-bit ids packed into words against the 32-bit static_vector they are widened into
+    template<std::size_t N>
+    void bench_packed(runner &bench)
+    {
+        ksv::static_vector<std::uint32_t, N> wide;
+        for (std::size_t i{0}; i < N; ++i)
+            wide.push_back(static_cast<std::uint32_t>((i * 2654435761u) & 0xfffff));
+        ksv::static_packed_vector<20, N> packed{wide};
+        ksv::static_vector<std::uint32_t, N> out;
+
+        bench.run(bench_name<std::uint32_t, N>("unpack", "ksv::static_packed_vector<20>"), N, [&] {
+            packed.unpack(out);
+            do_not_optimize(out);
+        });
+
+        bench.run(bench_name<std::uint32_t, N>("unpack", "ksv::static_vector"), N, [&] {
+            out = wide;
+            do_not_optimize(out);
+        });
+
+        bench.run(bench_name<std::uint32_t, N>("pack", "ksv::static_packed_vector<20>"), N, [&] {
+            packed.pack(wide);
+            do_not_optimize(packed);
+        });
+
+        bench.run(bench_name<std::uint32_t, N>("random_access", "ksv::static_packed_vector<20>"), N, [&] {
+            std::uint64_t sum{0};
+            for (std::size_t i{0}, idx{0}; i < N; ++i, idx = (idx + 97) % N)
+                sum += packed[idx];
+            do_not_optimize(sum);
+        });
+
+        bench.run(bench_name<std::uint32_t, N>("random_access", "ksv::static_vector"), N, [&] {
+            std::uint64_t sum{0};
+            for (std::size_t i{0}, idx{0}; i < N; ++i, idx = (idx + 97) % N)
+                sum += wide[idx];
+            do_not_optimize(sum);
+        });
+    }
+
+    // timer queue hold model: each operation pops the earliest deadline and
+    // pushes it back further out, keeping N / 2 pending deadlines
+    template<typename Q>
+    void bench_hold(runner &bench, std::string_view container, std::size_t n, const std::vector<std::uint64_t> &delays)
+    {
+        for (const auto &[op, monotonic] : {std::pair{"hold_random", false}, std::pair{"hold_monotonic", true}})
+        {
+            Q queue;
+            for (std::size_t i{0}; i < n / 2; ++i)
+                queue.push(monotonic ? i : delays[i]);
+            std::size_t next{0};
+            bench.run(std::string{op}.append("/").append(container).append("/int/").append(std::to_string(n)), n, [&] {
+                for (std::size_t i{0}; i < n; ++i)
+                {
+                    const std::uint64_t now{queue.top()};
+                    queue.pop();
+                    queue.push(now + (monotonic ? n / 2 : delays[next]));
+                    next = (next + 1) % delays.size();
+                }
+                do_not_optimize(queue.top());
+            });
+        }
+    }
+
+    template<std::size_t N>
+    void bench_priority_queues(runner &bench)
+    {
+        std::vector<std::uint64_t> delays;
+        std::uint64_t state{88172645463325252ull};
+        for (std::size_t i{0}; i < 4096; ++i)
+            delays.push_back(next_random(state) % (16 * N));
+
+        using key = std::uint64_t;
+        bench_hold<ksv::static_priority_queue<key, N, std::greater<>, 2>>(bench, "ksv::static_priority_queue<2>", N, delays);
+        bench_hold<ksv::static_priority_queue<key, N, std::greater<>, 4>>(bench, "ksv::static_priority_queue<4>", N, delays);
+        bench_hold<ksv::static_priority_queue<key, N, std::greater<>, 8>>(bench, "ksv::static_priority_queue<8>", N, delays);
+        bench_hold<std::priority_queue<key, std::vector<key>, std::greater<>>>(bench, "std::priority_queue", N, delays);
+    }
+
+    // lookups of random keys, half of them absent, in N sorted even ints;
+    // both containers live on the heap since the largest take 512 KiB
+    template<std::size_t N>
+    void bench_search(runner &bench)
+    {
+        auto sorted{std::make_unique<ksv::static_vector<int, N>>()};
+        for (std::size_t i{0}; i < N; ++i)
+            sorted->push_back(static_cast<int>(2 * i));
+        const auto index{std::make_unique<ksv::static_search_index<int, N>>(*sorted)};
+
+        std::vector<int> keys;
+        std::uint64_t state{88172645463325252ull};
+        for (std::size_t i{0}; i < 4096; ++i)
+            keys.push_back(static_cast<int>(next_random(state) % (2 * N)));
+
+        bench.run(bench_name<int, N>("lower_bound", "ksv::static_search_index"), keys.size(), [&] {
+            std::size_t sum{0};
+            for (const int key : keys)
+                sum += index->lower_bound(key);
+            do_not_optimize(sum);
+        });
+
+        bench.run(bench_name<int, N>("lower_bound", "std::lower_bound"), keys.size(), [&] {
+            std::size_t sum{0};
+            for (const int key : keys)
+                sum += static_cast<std::size_t>(std::lower_bound(sorted->begin(), sorted->end(), key) - sorted->begin());
+            do_not_optimize(sum);
+        });
+    }
+
+    // vectors whose sizes follow the mix small_vector is meant for: 99% of
+    // them hold 8 to 32 elements, the rest 100 to 500, which static_vector
+    // has to reserve for every vector
+    template<typename C>
+    void bench_size_mix(runner &bench, std::string_view container, const std::vector<std::size_t> &sizes)
+    {
+        std::size_t elements{0};
+        for (const std::size_t size : sizes)
+            elements += size;
+
+        bench.run(bench_name<int, 512>("size_mix_fill", container), elements, [&] {
+            std::size_t sum{0};
+            for (const std::size_t size : sizes)
+            {
+                C values;
+                for (std::size_t i{0}; i < size; ++i)
+                    values.push_back(static_cast<int>(i));
+                for (const int value : values)
+                    sum += static_cast<std::size_t>(value);
+            }
+            do_not_optimize(sum);
+        });
+
+        std::vector<C> filled(sizes.size());
+        for (std::size_t i{0}; i < sizes.size(); ++i)
+            for (std::size_t j{0}; j < sizes[i]; ++j)
+                filled[i].push_back(static_cast<int>(j));
+        bench.run(bench_name<int, 512>("size_mix_copy", container), elements, [&] {
+            for (const C &values : filled)
+            {
+                C copy{values};
+                do_not_optimize(copy);
+            }
+        });
+    }
+
+    void bench_small_vectors(runner &bench)
+    {
+        std::vector<std::size_t> sizes;
+        std::uint64_t state{88172645463325252ull};
+        for (std::size_t i{0}; i < 1024; ++i)
+        {
+            const std::uint64_t draw{next_random(state)};
+            sizes.push_back(draw % 100 == 0 ? 100 + draw / 100 % 401 : 8 + draw / 100 % 25);
+        }
+
+        bench_size_mix<ksv::small_vector<int, 32>>(bench, "ksv::small_vector<32>", sizes);
+        bench_size_mix<ksv::static_vector<int, 512>>(bench, "ksv::static_vector", sizes);
+        bench_size_mix<std::vector<int>>(bench, "std::vector", sizes);
+    }
+
+    // one producer thread hands items to one consumer, on two pinned cpus:
+    // throughput pushes and pops single items, throughput_batch runs of up
+    // to 64 where the queue has push_n and pop_n, and round_trip sends every
+    // item back through a second queue before the next one goes out
+    template<typename Q>
+    void bench_handoff(runner &bench, std::string_view container)
+    {
+        constexpr std::size_t items{std::size_t{1} << 16};
+        constexpr std::size_t round_trips{std::size_t{1} << 12};
+        auto queue{std::make_unique<Q>()};
+        auto reply{std::make_unique<Q>()};
+        thread_team team{2};
+        const auto name{[container](std::string_view op) { return std::string{op}.append("/").append(container).append("/int/1024"); }};
+
+        const thread_team::job single{[&](std::size_t idx) {
+            backoff wait;
+            if (idx == 1)
+            {
+                for (std::uint64_t i{0}; i < items; ++i)
+                    while (!queue->try_push(i))
+                        wait();
+                return;
+            }
+            std::uint64_t sum{0};
+            std::uint64_t value{0};
+            for (std::size_t i{0}; i < items; ++i)
+            {
+                while (!queue->try_pop(value))
+                    wait();
+                sum += value;
+            }
+            do_not_optimize(sum);
+        }};
+        bench.run(name("throughput"), items, [&] { team.run(single); });
+
+        if constexpr (requires(std::uint64_t *values) { queue->push_n(values, 64); queue->pop_n(values, 64); })
+        {
+            const thread_team::job batched{[&](std::size_t idx) {
+                constexpr std::size_t run{64};
+                std::uint64_t values[run];
+                backoff wait;
+                if (idx == 1)
+                {
+                    for (std::size_t sent{0}; sent < items;)
+                    {
+                        const std::size_t count{std::min(run, items - sent)};
+                        for (std::size_t i{0}; i < count; ++i)
+                            values[i] = sent + i;
+                        std::size_t pushed{0};
+                        while ((pushed += queue->push_n(values + pushed, count - pushed)) < count)
+                            wait();
+                        sent += count;
+                    }
+                    return;
+                }
+                std::uint64_t sum{0};
+                for (std::size_t received{0}; received < items;)
+                {
+                    const std::size_t count{queue->pop_n(values, run)};
+                    if (count == 0)
+                        wait();
+                    for (std::size_t i{0}; i < count; ++i)
+                        sum += values[i];
+                    received += count;
+                }
+                do_not_optimize(sum);
+            }};
+            bench.run(name("throughput_batch"), items, [&] { team.run(batched); });
+        }
+
+        const thread_team::job echo{[&](std::size_t idx) {
+            backoff wait;
+            std::uint64_t value{0};
+            for (std::uint64_t i{0}; i < round_trips; ++i)
+            {
+                if (idx == 0)
+                {
+                    while (!queue->try_push(i))
+                        wait();
+                    while (!reply->try_pop(value))
+                        wait();
+                }
+                else
+                {
+                    while (!queue->try_pop(value))
+                        wait();
+                    while (!reply->try_push(value))
+                        wait();
+                }
+            }
+            do_not_optimize(value);
+        }};
+        bench.run(name("round_trip"), round_trips, [&] { team.run(echo); });
+    }
+
+    // producers and as many consumers, threads pinned to distinct cpus while
+    // there are enough, passing items through one queue; the name ends in the
+    // number of producers. try_ variants spin on try_push and try_pop, the
+    // blocking variant waits in push and pop
+    template<typename Q, bool Blocking>
+    void bench_scaling(runner &bench, std::string_view container, std::size_t producers)
+    {
+        constexpr std::size_t items{std::size_t{1} << 16};
+        auto queue{std::make_unique<Q>()};
+        thread_team team{2 * producers};
+        const std::size_t share{items / producers};
+
+        const thread_team::job pass{[&](std::size_t idx) {
+            backoff wait;
+            if (idx >= producers)
+            {
+                for (std::uint64_t i{0}; i < share; ++i)
+                {
+                    if constexpr (Blocking)
+                        queue->push(i);
+                    else
+                        while (!queue->try_push(i))
+                            wait();
+                }
+                return;
+            }
+            std::uint64_t sum{0};
+            std::uint64_t value{0};
+            for (std::size_t i{0}; i < share; ++i)
+            {
+                if constexpr (Blocking)
+                    queue->pop(value);
+                else
+                    while (!queue->try_pop(value))
+                        wait();
+                sum += value;
+            }
+            do_not_optimize(sum);
+        }};
+        const std::string name{std::string{Blocking ? "scaling_blocking" : "scaling"}.append("/").append(container).append("/int/").append(std::to_string(producers))};
+        bench.run(name, items, [&] { team.run(pass); });
+    }
+
+    void bench_mpmc(runner &bench)
+    {
+        for (const std::size_t producers : {1, 2, 4, 8, 16})
+        {
+            bench_scaling<ksv::mpmc_queue<std::uint64_t, 1024>, false>(bench, "ksv::mpmc_queue", producers);
+            bench_scaling<ksv::mpmc_queue<std::uint64_t, 1024>, true>(bench, "ksv::mpmc_queue", producers);
+            bench_scaling<mutex_queue<std::uint64_t, 1024>, false>(bench, "mutex_queue", producers);
+        }
+    }
+
+    // associative containers of N int keys, 0, 2, ..., 2N - 2: find looks up
+    // random keys, half of them absent, and build inserts the keys in random
+    // order into an empty container; maps store the key as the value too
+    template<typename C, std::size_t N>
+    void bench_lookup_table(runner &bench, std::string_view container, const std::vector<int> &order, const std::vector<int> &lookups)
+    {
+        const auto add{[](C &table, int key) {
+            if constexpr (requires { typename C::mapped_type; })
+                table.emplace(key, key);
+            else
+                table.insert(key);
+        }};
+
+        C filled;
+        for (const int key : order)
+            add(filled, key);
+
+        bench.run(bench_name<int, N>("find", container), lookups.size(), [&] {
+            std::size_t found{0};
+            for (const int key : lookups)
+                found += filled.find(key) != filled.end();
+            do_not_optimize(found);
+        });
+
+        bench.run(bench_name<int, N>("build", container), N, [&] {
+            C table;
+            for (const int key : order)
+                add(table, key);
+            do_not_optimize(table);
+        });
+    }
+
+    template<std::size_t N>
+    void bench_lookup_tables(runner &bench)
+    {
+        std::vector<int> order;
+        for (std::size_t i{0}; i < N; ++i)
+            order.push_back(static_cast<int>(2 * i));
+        std::uint64_t state{88172645463325252ull};
+        for (std::size_t i{N}; i > 1; --i)
+            std::swap(order[i - 1], order[next_random(state) % i]);
+        std::vector<int> lookups;
+        for (std::size_t i{0}; i < 1024; ++i)
+            lookups.push_back(static_cast<int>(next_random(state) % (2 * N)));
+
+        bench_lookup_table<ksv::static_flat_map<int, int, N>, N>(bench, "ksv::static_flat_map", order, lookups);
+        bench_lookup_table<std::map<int, int>, N>(bench, "std::map", order, lookups);
+        bench_lookup_table<std::unordered_map<int, int>, N>(bench, "std::unordered_map", order, lookups);
+#if defined(KDS_BENCH_STD_FLAT)
+        bench_lookup_table<std::flat_map<int, int>, N>(bench, "std::flat_map", order, lookups);
+#endif
+        bench_lookup_table<ksv::static_flat_set<int, N>, N>(bench, "ksv::static_flat_set", order, lookups);
+        bench_lookup_table<std::set<int>, N>(bench, "std::set", order, lookups);
+        bench_lookup_table<std::unordered_set<int>, N>(bench, "std::unordered_set", order, lookups);
+#if defined(KDS_BENCH_STD_FLAT)
+        bench_lookup_table<std::flat_set<int>, N>(bench, "std::flat_set", order, lookups);
+#endif
+    }
+
+    // searches of full vectors holding 1 to N: find looks for random values
+    // of up to 5N / 4, a fifth of them absent, and count for a single one
+    template<typename T, std::size_t N>
+    void bench_find(runner &bench)
+    {
+        ksv::static_vector<T, N> filled;
+        for (std::size_t i{0}; i < N; ++i)
+            filled.push_back(static_cast<T>(i + 1));
+        std::vector<T> needles;
+        std::uint64_t state{88172645463325252ull};
+        for (std::size_t i{0}; i < 1024; ++i)
+            needles.push_back(static_cast<T>(next_random(state) % (N + N / 4) + 1));
+
+        bench.run(bench_name<T, N>("find", "ksv::find"), needles.size(), [&] {
+            std::size_t sum{0};
+            for (const T &needle : needles)
+                sum += static_cast<std::size_t>(ksv::find(filled, needle) - filled.begin());
+            do_not_optimize(sum);
+        });
+
+        bench.run(bench_name<T, N>("find", "std::find"), needles.size(), [&] {
+            std::size_t sum{0};
+            for (const T &needle : needles)
+                sum += static_cast<std::size_t>(std::find(filled.begin(), filled.end(), needle) - filled.begin());
+            do_not_optimize(sum);
+        });
+
+        bench.run(bench_name<T, N>("count", "ksv::count"), N, [&] {
+            do_not_optimize(ksv::count(filled, needles[0]));
+        });
+
+        bench.run(bench_name<T, N>("count", "std::count"), N, [&] {
+            do_not_optimize(std::count(filled.begin(), filled.end(), needles[0]));
+        });
+    }
+
+    // sorts of full vectors of N elements in four orders: random, already
+    // sorted, reversed and random among four distinct values. Every call
+    // copies and sorts 64 different inputs, so that the branch predictor
+    // cannot learn a single one; the strings fit the small string buffer
+    template<typename T, std::size_t N>
+    void bench_sort(runner &bench)
+    {
+        constexpr std::size_t batch{64};
+        constexpr std::array<std::string_view, 4> orders{"sort_random", "sort_sorted", "sort_reversed", "sort_few_unique"};
+        const auto make_key{[](std::uint64_t value) {
+            if constexpr (std::is_same_v<T, std::string>)
+                return std::string{"s"}.append(std::to_string(value % 100000));
+            else
+                return static_cast<T>(value % 100000);
+        }};
+
+        std::uint64_t state{88172645463325252ull};
+        for (std::size_t order{0}; order < orders.size(); ++order)
+        {
+            std::vector<ksv::static_vector<T, N>> inputs(batch);
+            for (ksv::static_vector<T, N> &input : inputs)
+            {
+                for (std::size_t i{0}; i < N; ++i)
+                    input.push_back(make_key(order == 3 ? next_random(state) % 4 : next_random(state)));
+                if (order == 1)
+                    std::sort(input.begin(), input.end());
+                else if (order == 2)
+                    std::sort(input.begin(), input.end(), std::greater<>());
+            }
+            std::vector<ksv::static_vector<T, N>> work(inputs);
+
+            bench.run(bench_name<T, N>(orders[order], "ksv::sort"), batch * N, [&] {
+                for (std::size_t b{0}; b < batch; ++b)
+                {
+                    work[b] = inputs[b];
+                    ksv::sort(work[b]);
+                }
+                do_not_optimize(work);
+            });
+
+            bench.run(bench_name<T, N>(orders[order], "std::sort"), batch * N, [&] {
+                for (std::size_t b{0}; b < batch; ++b)
+                {
+                    work[b] = inputs[b];
+                    std::sort(work[b].begin(), work[b].end());
+                }
+                do_not_optimize(work);
+            });
+        }
+    }
+
+    // hash maps of N int or short string keys, the strings fit the small
+    // string buffer; find looks up random keys, half of them absent, build
+    // inserts the keys into the cleared map and churn erases and reinserts
+    // each of them. The static maps live on the heap as the largest take
+    // 320 KiB, and std::unordered_map keeps its buckets across clear()
+    template<typename M, typename K, std::size_t N>
+    void bench_hash_map(runner &bench, std::string_view container, const std::vector<K> &keys, const std::vector<K> &lookups)
+    {
+        const auto table{std::make_unique<M>()};
+        for (const K &key : keys)
+            table->try_emplace(key, 1);
+
+        bench.run(bench_name<K, N>("find", container), lookups.size(), [&] {
+            std::size_t found{0};
+            for (const K &key : lookups)
+                found += table->find(key) != table->end();
+            do_not_optimize(found);
+        });
+
+        bench.run(bench_name<K, N>("build", container), N, [&] {
+            table->clear();
+            for (const K &key : keys)
+                table->try_emplace(key, 1);
+            do_not_optimize(*table);
+        });
+
+        bench.run(bench_name<K, N>("churn", container), N, [&] {
+            for (const K &key : keys)
+            {
+                table->erase(key);
+                table->try_emplace(key, 1);
+            }
+            do_not_optimize(*table);
+        });
+    }
+
+    template<typename K, std::size_t N>
+    void bench_hash_maps(runner &bench)
+    {
+        std::uint64_t state{88172645463325252ull};
+        std::unordered_set<std::uint32_t> seen;
+        std::vector<K> keys;
+        std::vector<K> absent;
+        while (absent.size() < N)
+        {
+            const auto value{static_cast<std::uint32_t>(next_random(state))};
+            if (!seen.insert(value).second)
+                continue;
+            K key;
+            if constexpr (std::is_same_v<K, std::string>)
+                key = std::string{"k"}.append(std::to_string(value));
+            else
+                key = static_cast<K>(value);
+            (keys.size() < N ? keys : absent).push_back(std::move(key));
+        }
+        std::vector<K> lookups;
+        for (std::size_t i{0}; i < 4096; ++i)
+            lookups.push_back((next_random(state) & 1 ? keys : absent)[next_random(state) % N]);
+
+        bench_hash_map<ksv::static_unordered_map<K, int, N>, K, N>(bench, "ksv::static_unordered_map", keys, lookups);
+        bench_hash_map<std::unordered_map<K, int>, K, N>(bench, "std::unordered_map", keys, lookups);
+    }
+
+    template<typename T, std::size_t N>
+    void bench_all(runner &bench)
+    {
+        bench_sequence<ksv::static_vector<T, N>, T, N>(bench, "ksv::static_vector");
+        bench_sequence<std::vector<T>, T, N>(bench, "std::vector");
+#if defined(KDS_BENCH_BOOST)
+        bench_sequence<boost::container::static_vector<T, N>, T, N>(bench, "boost::static_vector");
+#endif
+        bench_array<T, N>(bench);
+    }
+
+}// namespace
+
+int main(int argc, char **argv)
+{
+    runner bench{argc > 1 ? argv[1] : ""};
+    bench_all<int, 16>(bench);
+    bench_all<int, 256>(bench);
+    bench_all<int, 4096>(bench);
+    bench_all<std::string, 16>(bench);
+    bench_all<std::string, 256>(bench);
+    bench_all<std::string, 4096>(bench);
+    bench_small_vectors(bench);
+    bench_handoff<ksv::spsc_queue<std::uint64_t, 1024>>(bench, "ksv::spsc_queue");
+    bench_handoff<mutex_queue<std::uint64_t, 1024>>(bench, "mutex_queue");
+    bench_mpmc(bench);
+    bench_lookup_tables<4>(bench);
+    bench_lookup_tables<8>(bench);
+    bench_lookup_tables<16>(bench);
+    bench_lookup_tables<32>(bench);
+    bench_lookup_tables<64>(bench);
+    bench_sort<int, 4>(bench);
+    bench_sort<int, 8>(bench);
+    bench_sort<int, 16>(bench);
+    bench_sort<int, 32>(bench);
+    bench_sort<double, 8>(bench);
+    bench_sort<double, 32>(bench);
+    bench_sort<std::string, 8>(bench);
+    bench_sort<std::string, 32>(bench);
+    bench_find<int, 16>(bench);
+    bench_find<int, 64>(bench);
+    bench_find<int, 256>(bench);
+    bench_find<int, 1024>(bench);
+    bench_find<double, 16>(bench);
+    bench_find<double, 64>(bench);
+    bench_find<double, 256>(bench);
+    bench_find<double, 1024>(bench);
+    bench_hash_maps<int, 256>(bench);
+    bench_hash_maps<int, 4096>(bench);
+    bench_hash_maps<std::string, 256>(bench);
+    bench_hash_maps<std::string, 4096>(bench);
+    bench_flags<256>(bench);
+    bench_flags<4096>(bench);
+    bench_columns<256>(bench);
+    bench_columns<4096>(bench);
+    bench_packed<256>(bench);
+    bench_packed<4096>(bench);
+    bench_priority_queues<256>(bench);
+    bench_priority_queues<4096>(bench);
+    bench_search<64>(bench);
+    bench_search<256>(bench);
+    bench_search<1024>(bench);
+    bench_search<4096>(bench);
+    bench_search<16384>(bench);
+    bench_search<65536>(bench);
+    bench.print_json();
+}
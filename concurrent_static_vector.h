@@ -0,0 +1,170 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    // Fixed-capacity append-only vector that many threads may append to at once.
+    // Appending claims slots with a single fetch_add and constructs in place;
+    // readers see the prefix of elements whose construction has completed.
+    template<typename T, std::size_t N>
+    class concurrent_static_vector
+    {
+    public:
+        // type aliases
+        using value_type = T;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using const_iterator = const T *;
+        using const_riterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        // ctors
+        concurrent_static_vector() noexcept = default;
+
+        concurrent_static_vector(const concurrent_static_vector &) = delete;
+
+        concurrent_static_vector &operator=(const concurrent_static_vector &) = delete;
+
+        // dtor
+        ~concurrent_static_vector()
+        {
+            clear();
+        }
+
+        // non-mutating functions
+        // number of elements in the fully constructed prefix
+        [[nodiscard]] size_type size() const noexcept { return published.load(std::memory_order_acquire); }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] size_type capacity() const noexcept { return N; }
+
+        // validated element access, pos must lie in the published prefix
+        const_reference at(size_type pos) const
+        {
+            if (pos >= size())
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+            return storage.ptr()[pos];
+        }
+
+        // non-validated element access
+        const_reference operator[](size_type pos) const { return storage.ptr()[pos]; }
+
+        // iterators over the published prefix at the time of the call
+        const_iterator begin() const noexcept { return storage.ptr(); }
+
+        const_iterator end() const noexcept { return storage.ptr() + size(); }
+
+        const_riterator rbegin() const noexcept { return const_riterator(end()); }
+
+        const_riterator rend() const noexcept { return const_riterator(begin()); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        const_iterator cend() const noexcept { return end(); }
+
+        const_pointer data() const noexcept { return storage.ptr(); }
+
+        // concurrent addition
+        void push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args &&...args)
+        {
+            return emplace_at(reserve_n(1), std::forward<Args>(args)...);
+        }
+
+        // returns nullptr instead of failing when full
+        template<typename... Args>
+        pointer try_emplace_back(Args &&...args)
+        {
+            const size_type idx{reserved.fetch_add(1, std::memory_order_relaxed)};
+            if (idx >= N)
+                return nullptr;
+            return &emplace_at(idx, std::forward<Args>(args)...);
+        }
+
+        // claims count contiguous slots with one atomic operation and returns
+        // the index of the first; each must then be filled through emplace_at
+        size_type reserve_n(size_type count)
+        {
+            const size_type first{reserved.fetch_add(count, std::memory_order_relaxed)};
+            if (first > N || count > N - first)
+                KSV_THROW(std::bad_alloc(), "Exceeded capacity.");
+            return first;
+        }
+
+        // constructs the element of a reserved slot and publishes it; if the
+        // constructor throws, the slot is never published and the visible
+        // prefix stops in front of it
+        template<typename... Args>
+        reference emplace_at(size_type idx, Args &&...args)
+        {
+            pointer elem{std::construct_at(storage.ptr() + idx, std::forward<Args>(args)...)};
+            ready[idx].store(true);
+            advance_published();
+            return *elem;
+        }
+
+        // removal, must not run concurrently with any other member
+        void clear() noexcept
+        {
+            const size_type claimed{std::min(reserved.load(std::memory_order_relaxed), N)};
+            for (size_type i{claimed}; i > 0; --i)
+            {
+                if (ready[i - 1].load(std::memory_order_relaxed))
+                {
+                    if constexpr (!std::is_trivially_destructible_v<T>)
+                        std::destroy_at(storage.ptr() + (i - 1));// reverse order
+                    ready[i - 1].store(false, std::memory_order_relaxed);
+                }
+            }
+            reserved.store(0, std::memory_order_relaxed);
+            published.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        // instance fields
+        // reserved counts claimed slots and may run past N when appends fail,
+        // published is the length of the prefix whose ready flags are all set
+        alignas(detail::cache_line_size) std::atomic<size_type> reserved{0};
+        alignas(detail::cache_line_size) std::atomic<size_type> published{0};
+        std::atomic<bool> ready[N]{};
+        detail::byte_storage<T, N> storage;
+
+        // moves published past every ready slot following it; sequentially
+        // consistent so that of two writers finishing neighbouring slots at
+        // least one observes the other and carries the prefix forward
+        void advance_published() noexcept
+        {
+            size_type pos{published.load()};
+            while (pos < N && ready[pos].load())
+                if (published.compare_exchange_weak(pos, pos + 1))
+                    ++pos;
+        }
+    };
+
+}// namespace ksv
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    // Lock-free bounded queue for any number of producer and consumer threads,
+    // with elements constructed in place in N cache-line padded slots.
+    // Each slot carries a sequence number telling which turn it is ready for,
+    // so producers and consumers only contend on their own position counter.
+    // The constructor used for pushing and the move assignment used for popping
+    // should not throw: a throw leaves the claimed slot, and the queue, stuck.
+    template<typename T, std::size_t N>
+    class mpmc_queue
+    {
+        static_assert(N > 0, "mpmc_queue needs a non-zero capacity.");
+
+    public:
+        // type aliases
+        using value_type = T;
+        using reference = T &;
+        using const_reference = const T &;
+        using size_type = std::size_t;
+
+        // ctors
+        mpmc_queue() noexcept
+        {
+            for (size_type i{0}; i < N; ++i)
+                slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+
+        mpmc_queue(const mpmc_queue &) = delete;
+
+        mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+        // dtor
+        ~mpmc_queue()
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                const size_type last{enqueue_pos.load(std::memory_order_relaxed)};
+                for (size_type pos{dequeue_pos.load(std::memory_order_relaxed)}; pos < last; ++pos)
+                    std::destroy_at(slots[wrap(pos)].ptr());
+            }
+        }
+
+        // non-mutating functions
+        // only exact while no other thread pushes or pops
+        [[nodiscard]] size_type size() const noexcept
+        {
+            const size_type pushed{enqueue_pos.load(std::memory_order_acquire)};
+            const size_type popped{dequeue_pos.load(std::memory_order_acquire)};
+            return pushed > popped ? pushed - popped : 0;
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] size_type capacity() const noexcept { return N; }
+
+        // non-blocking addition, returns false when full
+        bool try_push(const T &value)
+        {
+            return try_emplace(value);
+        }
+
+        bool try_push(T &&value)
+        {
+            return try_emplace(std::move(value));
+        }
+
+        template<typename... Args>
+        bool try_emplace(Args &&...args)
+        {
+            size_type pos{enqueue_pos.load(std::memory_order_relaxed)};
+            for (;;)
+            {
+                const auto diff{distance(slots[wrap(pos)].seq.load(std::memory_order_acquire), pos)};
+                if (diff == 0)
+                {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;// slot still holds the element from the previous round
+                else
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+            construct(pos, std::forward<Args>(args)...);
+            return true;
+        }
+
+        // blocking addition, claims a position and waits until its slot is free
+        void push(const T &value)
+        {
+            emplace(value);
+        }
+
+        void push(T &&value)
+        {
+            emplace(std::move(value));
+        }
+
+        template<typename... Args>
+        void emplace(Args &&...args)
+        {
+            const size_type pos{enqueue_pos.fetch_add(1, std::memory_order_relaxed)};
+            wait_for(pos, pos);
+            construct(pos, std::forward<Args>(args)...);
+        }
+
+        // non-blocking removal, returns false when empty
+        bool try_pop(T &out)
+        {
+            size_type pos{dequeue_pos.load(std::memory_order_relaxed)};
+            for (;;)
+            {
+                const auto diff{distance(slots[wrap(pos)].seq.load(std::memory_order_acquire), pos + 1)};
+                if (diff == 0)
+                {
+                    if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;// slot not yet filled for this round
+                else
+                    pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+            extract(pos, out);
+            return true;
+        }
+
+        // blocking removal, claims a position and waits until its slot is filled
+        void pop(T &out)
+        {
+            const size_type pos{dequeue_pos.fetch_add(1, std::memory_order_relaxed)};
+            wait_for(pos, pos + 1);
+            extract(pos, out);
+        }
+
+    private:
+        // a slot is ready for the producer of position pos when seq == pos,
+        // and for its consumer when seq == pos + 1
+        struct alignas(detail::cache_line_size) slot
+        {
+            std::atomic<size_type> seq;
+            alignas(T) std::byte buffer[sizeof(T)];// no object of type T created yet
+
+            T *ptr() noexcept { return std::launder(reinterpret_cast<T *>(buffer)); }
+        };
+
+        // instance fields
+        alignas(detail::cache_line_size) std::atomic<size_type> enqueue_pos{0};
+        alignas(detail::cache_line_size) std::atomic<size_type> dequeue_pos{0};
+        slot slots[N];
+
+        static constexpr size_type wrap(size_type pos) noexcept
+        {
+            if constexpr ((N & (N - 1)) == 0)
+                return pos & (N - 1);
+            else
+                return pos % N;
+        }
+
+        // signed distance between a sequence number and the one expected
+        static constexpr std::ptrdiff_t distance(size_type seq, size_type expected) noexcept
+        {
+            return static_cast<std::ptrdiff_t>(seq - expected);
+        }
+
+        void wait_for(size_type pos, size_type expected) noexcept
+        {
+            std::atomic<size_type> &seq{slots[wrap(pos)].seq};
+            for (size_type curr{seq.load(std::memory_order_acquire)}; curr != expected; curr = seq.load(std::memory_order_acquire))
+                seq.wait(curr, std::memory_order_acquire);
+        }
+
+        // fills the claimed slot and hands it to the consumer of pos
+        template<typename... Args>
+        void construct(size_type pos, Args &&...args)
+        {
+            slot &target{slots[wrap(pos)]};
+            std::construct_at(target.ptr(), std::forward<Args>(args)...);
+            target.seq.store(pos + 1, std::memory_order_release);
+            target.seq.notify_all();
+        }
+
+        // empties the claimed slot and hands it to the producer of pos + N
+        void extract(size_type pos, T &out)
+        {
+            slot &source{slots[wrap(pos)]};
+            out = std::move(*source.ptr());
+            std::destroy_at(source.ptr());
+            source.seq.store(pos + N, std::memory_order_release);
+            source.seq.notify_all();
+        }
+    };
+
+}// namespace ksv
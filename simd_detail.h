@@ -0,0 +1,69 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+
+// x86-64 builds compile the AVX2 paths with a target attribute and pick
+// them at run time, so they need no -mavx2
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define KSV_X86_DISPATCH 1
+#define KSV_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ksv
+{
+
+    namespace detail
+    {
+        // sorted key types searched by comparing 16 bytes at a time
+        template<typename K, typename Key, typename Compare>
+        inline constexpr bool simd_searchable = std::is_same_v<K, Key> &&
+                                                (std::is_same_v<Compare, std::less<K>> || std::is_same_v<Compare, std::less<>>) &&
+                                                ((std::is_integral_v<K> && !std::is_same_v<K, bool> && sizeof(K) <= 4) || std::is_same_v<K, float>);
+
+#if defined(__SSE2__)
+        template<typename K>
+        inline __m128i broadcast(K key) noexcept
+        {
+            if constexpr (std::is_same_v<K, float>)
+                return _mm_castps_si128(_mm_set1_ps(key));
+            else if constexpr (sizeof(K) == 1)
+                return _mm_set1_epi8(static_cast<char>(key));
+            else if constexpr (sizeof(K) == 2)
+                return _mm_set1_epi16(static_cast<short>(key));
+            else
+                return _mm_set1_epi32(static_cast<int>(key));
+        }
+
+        // one bit per byte of every lane where lhs > rhs
+        template<typename K>
+        inline unsigned greater_mask(__m128i lhs, __m128i rhs) noexcept
+        {
+            if constexpr (std::is_same_v<K, float>)
+                return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpgt_ps(_mm_castsi128_ps(lhs), _mm_castsi128_ps(rhs))));
+            else
+            {
+                if constexpr (std::is_unsigned_v<K>)
+                {
+                    // SSE2 only compares signed lanes, flipping the sign bit keeps the order
+                    const __m128i bias{broadcast(static_cast<K>(K(1) << (sizeof(K) * 8 - 1)))};
+                    lhs = _mm_xor_si128(lhs, bias);
+                    rhs = _mm_xor_si128(rhs, bias);
+                }
+                if constexpr (sizeof(K) == 1)
+                    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(lhs, rhs)));
+                else if constexpr (sizeof(K) == 2)
+                    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi16(lhs, rhs)));
+                else
+                    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(lhs, rhs))));
+            }
+        }
+#endif
+    }// namespace detail
+
+}// namespace ksv
@@ -0,0 +1,597 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ksv
+{
+
+    // Vector keeping up to N elements in an inline buffer like static_vector,
+    // moving them to heap storage with geometric growth only once N is exceeded.
+    template<typename T, std::size_t N, typename Alloc = std::allocator<T>>
+    class small_vector
+    {
+        static_assert(std::is_same_v<typename std::allocator_traits<Alloc>::value_type, T>, "Allocator must allocate T.");
+
+    public:
+        // type aliases
+        using value_type = T;
+        using allocator_type = Alloc;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using riterator = std::reverse_iterator<iterator>;
+        using const_riterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        // ctors
+        small_vector() noexcept(std::is_nothrow_default_constructible_v<Alloc>) : small_vector(Alloc()) {}
+
+        explicit small_vector(const Alloc &allocator) noexcept : alloc(allocator) {}
+
+        template<std::input_iterator Iter>
+        small_vector(Iter begin, Iter end, const Alloc &allocator = Alloc()) : small_vector(allocator)
+        {
+            append_guarded(std::ranges::subrange(begin, end));
+        }
+
+        template<std::ranges::input_range R>
+        small_vector(from_range_t, R &&range, const Alloc &allocator = Alloc()) : small_vector(allocator)
+        {
+            append_guarded(std::forward<R>(range));
+        }
+
+        small_vector(std::initializer_list<T> list, const Alloc &allocator = Alloc()) : small_vector(std::begin(list), std::end(list), allocator) {}
+
+        small_vector(size_type count, const T &value, const Alloc &allocator = Alloc()) : small_vector(allocator)
+        {
+            resize_guarded(count, [this, &value] { eb_internal(value); });
+        }
+
+        small_vector(const small_vector &other)
+            : small_vector(other.begin(), other.end(), alloc_traits::select_on_container_copy_construction(other.alloc)) {}
+
+        small_vector(small_vector &&other) noexcept(nothrow_relocatable) : alloc(std::move(other.alloc))
+        {
+            take_elements(other);
+        }
+
+        // assignments
+        small_vector &operator=(const small_vector &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+                {
+                    // the incoming allocator may not be able to free memory of the current one
+                    if (!alloc_traits::is_always_equal::value && alloc != other.alloc)
+                        release_heap();
+                    alloc = other.alloc;
+                }
+                append_guarded(other);
+            }
+            return *this;
+        }
+
+        small_vector &operator=(small_vector &&other) noexcept((alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) && nothrow_relocatable)
+        {
+            if (this == &other)
+                return *this;
+
+            if constexpr (!alloc_traits::propagate_on_container_move_assignment::value && !alloc_traits::is_always_equal::value)
+            {
+                // memory of other cannot be adopted, move element by element
+                if (alloc != other.alloc)
+                {
+                    clear();
+                    append_guarded(std::ranges::subrange(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())));
+                    other.clear();
+                    return *this;
+                }
+            }
+
+            clear();
+            release_heap();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+                alloc = std::move(other.alloc);
+            take_elements(other);
+            return *this;
+        }
+
+        small_vector &operator=(std::initializer_list<T> list)
+        {
+            clear();
+            append_guarded(list);
+            return *this;
+        }
+
+        // dtor
+        ~small_vector()
+        {
+            clear();
+            release_heap();
+        }
+
+        // non-mutating functions
+        [[nodiscard]] bool empty() const noexcept { return curr_size == 0; }
+
+        [[nodiscard]] size_type size() const noexcept { return curr_size; }
+
+        [[nodiscard]] size_type capacity() const noexcept { return curr_capacity; }
+
+        [[nodiscard]] size_type max_size() const noexcept { return alloc_traits::max_size(alloc); }
+
+        // true while the elements live in the inline buffer
+        [[nodiscard]] bool is_inline() const noexcept { return first == storage.ptr(); }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept { return alloc; }
+
+        // validated element access
+        const_reference at(size_type pos) const
+        {
+            validate_index(pos);
+            return first[pos];
+        }
+
+        reference at(size_type pos)
+        {
+            validate_index(pos);
+            return first[pos];
+        }
+
+        // non-validated element access
+        const_reference operator[](size_type pos) const { return first[pos]; }
+
+        reference operator[](size_type pos) { return first[pos]; }
+
+        const_reference front() const { return first[0]; }
+
+        reference front() { return first[0]; }
+
+        const_reference back() const { return first[curr_size - 1]; }
+
+        reference back() { return first[curr_size - 1]; }
+
+        // iterators
+        iterator begin() noexcept { return first; }
+
+        riterator rbegin() noexcept { return riterator(end()); }
+
+        const_iterator begin() const noexcept { return first; }
+
+        const_riterator rbegin() const noexcept { return const_riterator(end()); }
+
+        iterator end() noexcept { return first + curr_size; }
+
+        riterator rend() noexcept { return riterator(begin()); }
+
+        const_iterator end() const noexcept { return first + curr_size; }
+
+        const_riterator rend() const noexcept { return const_riterator(begin()); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        const_riterator crbegin() const noexcept { return rbegin(); }
+
+        const_iterator cend() const noexcept { return end(); }
+
+        const_riterator crend() const noexcept { return rend(); }
+
+        // underlying buffer access
+        pointer data() noexcept { return first; }
+
+        const_pointer data() const noexcept { return first; }
+
+        // mutating functions
+        // capacity
+        void reserve(size_type new_capacity)
+        {
+            if (new_capacity > curr_capacity)
+                reallocate(new_capacity);
+        }
+
+        // moves the elements back into the inline buffer when they fit, or
+        // into an allocation of exactly size() elements otherwise
+        void shrink_to_fit()
+        {
+            if (is_inline() || curr_size == curr_capacity)
+                return;
+
+            if (curr_size <= N)
+            {
+                pointer heap{first};
+                const size_type heap_capacity{curr_capacity};
+                relocate(heap, curr_size, storage.ptr());
+                first = storage.ptr();
+                curr_capacity = N;
+                alloc_traits::deallocate(alloc, heap, heap_capacity);
+            }
+            else
+                reallocate(curr_size);
+        }
+
+        // addition
+        void push_back(const_reference value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(value_type &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args &&...args)
+        {
+            if (curr_size == curr_capacity)
+                return emplace_back_grow(std::forward<Args>(args)...);
+            eb_internal(std::forward<Args>(args)...);
+            return back();
+        }
+
+        template<std::ranges::input_range R>
+        void append_range(R &&range)
+        {
+            append_guarded(std::forward<R>(range));
+        }
+
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args &&...args)
+        {
+            const size_type idx{static_cast<size_type>(pos - cbegin())};
+            emplace_back(std::forward<Args>(args)...);
+            std::rotate(begin() + idx, end() - 1, end());
+            return begin() + idx;
+        }
+
+        iterator insert(const_iterator pos, const_reference value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, value_type &&value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        template<std::input_iterator Iter>
+        iterator insert(const_iterator pos, Iter begin_it, Iter end_it)
+        {
+            // append in one pass, then rotate the new elements into place
+            const size_type idx{static_cast<size_type>(pos - cbegin())};
+            const size_type old_size{curr_size};
+            append_guarded(std::ranges::subrange(begin_it, end_it));
+            std::rotate(begin() + idx, begin() + old_size, end());
+            return begin() + idx;
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> list)
+        {
+            return insert(pos, list.begin(), list.end());
+        }
+
+        // removal
+        void pop_back()
+        {
+            --curr_size;
+            alloc_traits::destroy(alloc, first + curr_size);
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator begin_it, const_iterator end_it)
+        {
+            const size_type idx{static_cast<size_type>(begin_it - cbegin())};
+            const size_type count{static_cast<size_type>(end_it - begin_it)};
+            if (count == 0)
+                return begin() + idx;
+
+            if constexpr (trivially_relocatable)
+            {
+                destroy_elements(first + idx, count);
+                std::memmove(static_cast<void *>(first + idx), first + idx + count, (curr_size - idx - count) * sizeof(T));
+                curr_size -= count;
+            }
+            else
+            {
+                std::move(begin() + idx + count, end(), begin() + idx);
+                truncate(curr_size - count);
+            }
+            return begin() + idx;
+        }
+
+        void clear() noexcept
+        {
+            truncate(0);
+        }
+
+        // resizing
+        void resize(size_type count)
+        {
+            if (count <= curr_size)
+                truncate(count);
+            else
+                resize_guarded(count, [this] { eb_internal(); });
+        }
+
+        void resize(size_type count, const_reference value)
+        {
+            if (count <= curr_size)
+                truncate(count);
+            else
+            {
+                // value may refer to an element that moves when growing
+                const T copy{value};
+                resize_guarded(count, [this, &copy] { eb_internal(copy); });
+            }
+        }
+
+        // swap
+        friend void swap(small_vector &lhs, small_vector &rhs) noexcept(std::is_nothrow_move_constructible_v<small_vector> && std::is_nothrow_move_assignable_v<small_vector>)
+        {
+            small_vector tmp{std::move(lhs)};
+            lhs = std::move(rhs);
+            rhs = std::move(tmp);
+        }
+
+        // comparison operators
+        friend bool operator==(const small_vector &lhs, const small_vector &rhs)
+        {
+            return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        // ordered like std::vector, by T's <=> or else by its <
+        friend auto operator<=>(const small_vector &lhs, const small_vector &rhs)
+        {
+            return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), detail::synth_three_way{});
+        }
+
+    private:
+        using alloc_traits = std::allocator_traits<Alloc>;
+
+        // instance fields
+        // first points either into storage or to a heap allocation of curr_capacity elements
+        [[no_unique_address]] Alloc alloc;
+        pointer first{storage.ptr()};
+        size_type curr_size{0};
+        size_type curr_capacity{N};
+        detail::byte_storage<T, N> storage;
+
+        // element types that may be copied as raw bytes
+        static constexpr bool trivially_copyable = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+
+        // element types that may be moved as raw bytes
+        static constexpr bool trivially_relocatable = is_trivially_relocatable_v<T>;
+
+        // element types whose relocation cannot throw, which moving an inline vector needs
+        static constexpr bool nothrow_relocatable = trivially_relocatable || std::is_nothrow_move_constructible_v<T>;
+
+        // methods for validation
+        void validate_index(size_type index) const
+        {
+            if (index >= curr_size)
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+        }
+
+        // capacity after growing to hold at least required elements
+        size_type next_capacity(size_type required) const
+        {
+            if (required > max_size())
+                KSV_THROW(std::length_error("Exceeded max size."), "Exceeded max size.");
+            return std::min(std::max(required, 2 * curr_capacity), max_size());
+        }
+
+        // makes room for required elements, growing geometrically like
+        // emplace_back so that repeated appends stay amortized constant
+        void grow_to(size_type required)
+        {
+            if (required > curr_capacity)
+                reallocate(next_capacity(required));
+        }
+
+        // destroys the elements past new_size
+        void truncate(size_type new_size) noexcept
+        {
+            destroy_elements(first + new_size, curr_size - new_size);
+            curr_size = new_size;
+        }
+
+        // destroys count elements starting at pos, in reverse order
+        void destroy_elements(pointer pos, size_type count) noexcept
+        {
+            if constexpr (!trivially_copyable)
+                for (size_type i{count}; i > 0; --i)
+                    alloc_traits::destroy(alloc, pos + (i - 1));
+        }
+
+        void release_heap() noexcept
+        {
+            if (!is_inline())
+                alloc_traits::deallocate(alloc, first, curr_capacity);
+            first = storage.ptr();
+            curr_capacity = N;
+        }
+
+        // adopts the elements of other, which is left empty and inline
+        void take_elements(small_vector &other) noexcept(nothrow_relocatable)
+        {
+            if (other.is_inline())
+            {
+                relocate(other.first, other.curr_size, storage.ptr());
+                curr_size = other.curr_size;
+            }
+            else
+            {
+                first = other.first;
+                curr_size = other.curr_size;
+                curr_capacity = other.curr_capacity;
+                other.first = other.storage.ptr();
+                other.curr_capacity = N;
+            }
+            other.curr_size = 0;
+        }
+
+        // moves count elements from src into uninitialized dst and ends the source objects
+        void relocate(pointer src, size_type count, pointer dst) noexcept(nothrow_relocatable)
+        {
+            if constexpr (trivially_relocatable)
+                std::memcpy(static_cast<void *>(dst), src, count * sizeof(T));
+            else if constexpr (nothrow_relocatable)
+            {
+                for (size_type i{0}; i < count; ++i)
+                    alloc_traits::construct(alloc, dst + i, std::move(src[i]));
+                destroy_elements(src, count);
+            }
+            else
+            {
+                // copy when moving could throw, so a failed reallocation leaves the source intact
+                size_type built{0};
+                KSV_TRY
+                {
+                    for (; built < count; ++built)
+                        alloc_traits::construct(alloc, dst + built, std::move_if_noexcept(src[built]));
+                }
+                KSV_CATCH_ALL
+                {
+                    destroy_elements(dst, built);
+                    KSV_RETHROW;
+                }
+                destroy_elements(src, count);
+            }
+        }
+
+        void reallocate(size_type new_capacity)
+        {
+            pointer heap{alloc_traits::allocate(alloc, new_capacity)};
+            KSV_TRY
+            {
+                relocate(first, curr_size, heap);
+            }
+            KSV_CATCH_ALL
+            {
+                alloc_traits::deallocate(alloc, heap, new_capacity);
+                KSV_RETHROW;
+            }
+            const size_type old_size{curr_size};
+            release_heap();
+            first = heap;
+            curr_size = old_size;
+            curr_capacity = new_capacity;
+        }
+
+        // constructs the new element in the new allocation before relocating,
+        // since args may refer to an element of this vector
+        template<typename... Args>
+        reference emplace_back_grow(Args &&...args)
+        {
+            const size_type new_capacity{next_capacity(curr_size + 1)};
+            pointer heap{alloc_traits::allocate(alloc, new_capacity)};
+            KSV_TRY
+            {
+                alloc_traits::construct(alloc, heap + curr_size, std::forward<Args>(args)...);
+            }
+            KSV_CATCH_ALL
+            {
+                alloc_traits::deallocate(alloc, heap, new_capacity);
+                KSV_RETHROW;
+            }
+            KSV_TRY
+            {
+                relocate(first, curr_size, heap);
+            }
+            KSV_CATCH_ALL
+            {
+                alloc_traits::destroy(alloc, heap + curr_size);
+                alloc_traits::deallocate(alloc, heap, new_capacity);
+                KSV_RETHROW;
+            }
+            const size_type new_size{curr_size + 1};
+            release_heap();
+            first = heap;
+            curr_size = new_size;
+            curr_capacity = new_capacity;
+            return back();
+        }
+
+        // appends range, rolling back the appended elements on failure
+        template<typename R>
+        void append_guarded(R &&range)
+        {
+            const size_type old_size{curr_size};
+            KSV_TRY
+            {
+                if constexpr (std::ranges::sized_range<R>)
+                {
+                    const auto count{static_cast<size_type>(std::ranges::size(range))};
+                    grow_to(curr_size + count);
+                    auto iter{std::ranges::begin(range)};
+                    if constexpr (trivially_copyable && std::contiguous_iterator<decltype(iter)> && std::is_same_v<std::iter_value_t<decltype(iter)>, T>)
+                    {
+                        // an empty range may come with a null pointer, which memcpy rejects
+                        if (count != 0)
+                            std::memcpy(static_cast<void *>(first + curr_size), std::to_address(iter), count * sizeof(T));
+                        curr_size += count;
+                    }
+                    else
+                        for (size_type i{0}; i < count; ++i, ++iter)
+                            eb_internal(*iter);
+                }
+                else
+                    for (auto &&elem : range)
+                        emplace_back(std::forward<decltype(elem)>(elem));
+            }
+            KSV_CATCH_ALL
+            {
+                truncate(old_size);
+                KSV_RETHROW;
+            }
+        }
+
+        // grows to count elements with append, rolling back on failure
+        template<typename Append>
+        void resize_guarded(size_type count, Append append)
+        {
+            grow_to(count);
+            const size_type old_size{curr_size};
+            KSV_TRY
+            {
+                while (curr_size < count)
+                    append();
+            }
+            KSV_CATCH_ALL
+            {
+                truncate(old_size);
+                KSV_RETHROW;
+            }
+        }
+
+        // constructs at the end, capacity must already be available
+        template<typename... Args>
+        void eb_internal(Args &&...args)
+        {
+            alloc_traits::construct(alloc, first + curr_size, std::forward<Args>(args)...);
+            ++curr_size;
+        }
+    };
+
+}// namespace ksv
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    // Lock-free bounded queue for exactly one producer and one consumer thread,
+    // with elements stored in place like static_vector.
+    // Producer side: try_push, try_emplace, push_n. Consumer side: front, pop,
+    // try_pop, pop_n. size and empty may be called from either side.
+    template<typename T, std::size_t N>
+    class spsc_queue
+    {
+        static_assert(N > 0, "spsc_queue needs a non-zero capacity.");
+
+    public:
+        // type aliases
+        using value_type = T;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using size_type = std::size_t;
+
+        // ctors
+        spsc_queue() noexcept = default;
+
+        spsc_queue(const spsc_queue &) = delete;
+
+        spsc_queue &operator=(const spsc_queue &) = delete;
+
+        // dtor
+        ~spsc_queue()
+        {
+            if constexpr (!trivially_copyable)
+                while (front())
+                    pop();
+        }
+
+        // non-mutating functions
+        // only exact while the other side is idle
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] size_type capacity() const noexcept { return N; }
+
+        // producer side
+        bool try_push(const T &value)
+        {
+            return try_emplace(value);
+        }
+
+        bool try_push(T &&value)
+        {
+            return try_emplace(std::move(value));
+        }
+
+        template<typename... Args>
+        bool try_emplace(Args &&...args)
+        {
+            const size_type pos{tail.load(std::memory_order_relaxed)};
+            if (free_slots(pos) == 0)
+                return false;
+            std::construct_at(slot(pos), std::forward<Args>(args)...);
+            tail.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // pushes up to count elements from first, returns the number pushed;
+        // the elements are published together, trivially copyable contiguous
+        // input is copied in at most two memcpy runs
+        template<std::input_iterator Iter>
+        size_type push_n(Iter first, size_type count)
+        {
+            const size_type pos{tail.load(std::memory_order_relaxed)};
+            count = std::min(count, free_slots(pos, count));
+            if (count == 0)
+                return 0;// the input may be empty with a null pointer
+            if constexpr (trivially_copyable && std::contiguous_iterator<Iter> && std::is_same_v<std::iter_value_t<Iter>, T>)
+            {
+                const size_type first_run{std::min(count, N - wrap(pos))};
+                std::memcpy(static_cast<void *>(slot(pos)), std::to_address(first), first_run * sizeof(T));
+                std::memcpy(static_cast<void *>(slot(pos + first_run)), std::to_address(first) + first_run, (count - first_run) * sizeof(T));
+            }
+            else
+            {
+                size_type pushed{0};
+                KSV_TRY
+                {
+                    for (; pushed < count; ++pushed, ++first)
+                        std::construct_at(slot(pos + pushed), *first);
+                }
+                KSV_CATCH_ALL
+                {
+                    // publish what was constructed before the failure
+                    tail.store(pos + pushed, std::memory_order_release);
+                    KSV_RETHROW;
+                }
+            }
+            tail.store(pos + count, std::memory_order_release);
+            return count;
+        }
+
+        // consumer side
+        // oldest element, or nullptr when empty
+        pointer front() noexcept
+        {
+            const size_type pos{head.load(std::memory_order_relaxed)};
+            if (pos == cached_tail)
+            {
+                cached_tail = tail.load(std::memory_order_acquire);
+                if (pos == cached_tail)
+                    return nullptr;
+            }
+            return slot(pos);
+        }
+
+        // removes the oldest element, front() must have returned non-null
+        void pop() noexcept
+        {
+            const size_type pos{head.load(std::memory_order_relaxed)};
+            std::destroy_at(slot(pos));
+            head.store(pos + 1, std::memory_order_release);
+        }
+
+        bool try_pop(T &out) noexcept(std::is_nothrow_move_assignable_v<T>)
+        {
+            pointer elem{front()};
+            if (!elem)
+                return false;
+            out = std::move(*elem);
+            pop();
+            return true;
+        }
+
+        // moves up to count elements to out, returns the number popped;
+        // the slots are released together, like push_n in at most two runs
+        template<typename OutIter>
+        size_type pop_n(OutIter out, size_type count)
+        {
+            const size_type pos{head.load(std::memory_order_relaxed)};
+            if (cached_tail - pos < count)
+                cached_tail = tail.load(std::memory_order_acquire);
+            count = std::min(count, cached_tail - pos);
+            if (count == 0)
+                return 0;
+            if constexpr (trivially_copyable && std::contiguous_iterator<OutIter> && std::is_same_v<std::iter_value_t<OutIter>, T>)
+            {
+                const size_type first_run{std::min(count, N - wrap(pos))};
+                std::memcpy(static_cast<void *>(std::to_address(out)), slot(pos), first_run * sizeof(T));
+                std::memcpy(static_cast<void *>(std::to_address(out) + first_run), slot(pos + first_run), (count - first_run) * sizeof(T));
+            }
+            else
+            {
+                size_type popped{0};
+                KSV_TRY
+                {
+                    for (; popped < count; ++popped, ++out)
+                    {
+                        *out = std::move(*slot(pos + popped));
+                        std::destroy_at(slot(pos + popped));
+                    }
+                }
+                KSV_CATCH_ALL
+                {
+                    // release what was moved out before the failure
+                    head.store(pos + popped, std::memory_order_release);
+                    KSV_RETHROW;
+                }
+            }
+            head.store(pos + count, std::memory_order_release);
+            return count;
+        }
+
+    private:
+        // instance fields
+        // head and tail count pushes and pops since construction and are only
+        // written by the consumer and the producer respectively; each side
+        // keeps a cached copy of the other's index on its own cache line and
+        // only reloads it when the cache says the queue is full or empty
+        alignas(detail::cache_line_size) std::atomic<size_type> head{0};
+        size_type cached_tail{0};
+        alignas(detail::cache_line_size) std::atomic<size_type> tail{0};
+        size_type cached_head{0};
+        alignas(detail::cache_line_size) detail::byte_storage<T, N> storage;
+
+        // element types that may be copied as raw bytes and need no destruction
+        static constexpr bool trivially_copyable = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+
+        // index arithmetic is a mask for power-of-two capacities
+        static constexpr size_type wrap(size_type pos) noexcept
+        {
+            if constexpr ((N & (N - 1)) == 0)
+                return pos & (N - 1);
+            else
+                return pos % N;
+        }
+
+        pointer slot(size_type pos) noexcept { return storage.ptr() + wrap(pos); }
+
+        // slots the producer may fill starting at tail position pos, the
+        // consumer index is only reloaded when fewer than wanted seem free
+        size_type free_slots(size_type pos, size_type wanted = 1) noexcept
+        {
+            if (N - (pos - cached_head) < wanted)
+                cached_head = head.load(std::memory_order_acquire);
+            return N - (pos - cached_head);
+        }
+    };
+
+}// namespace ksv
@@ -0,0 +1,470 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    // Fixed-capacity vector of up to N bits packed into 64-bit words.
+    // Bits past size() are kept zero, so counting, searching and the bitwise
+    // operators work on whole words without masking.
+    template<std::size_t N>
+    class static_bitvector
+    {
+        template<bool Const>
+        class basic_iterator;
+
+    public:
+        class reference;
+
+        // type aliases
+        using value_type = bool;
+        using word_type = std::uint64_t;
+        using const_reference = bool;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using riterator = std::reverse_iterator<iterator>;
+        using const_riterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        static constexpr size_type bits_per_word{64};
+        static constexpr size_type word_count{(N + bits_per_word - 1) / bits_per_word};
+
+        // returned by the searches when no bit is set
+        static constexpr size_type npos{static_cast<size_type>(-1)};
+
+        // ctors
+        constexpr static_bitvector() noexcept = default;
+
+        constexpr static_bitvector(size_type count, bool value)
+        {
+            resize(count, value);
+        }
+
+        constexpr static_bitvector(std::initializer_list<bool> list)
+        {
+            validate_count(list.size());
+            for (const bool value : list)
+                push_back(value);
+        }
+
+        // non-mutating functions
+        [[nodiscard]] constexpr bool empty() const noexcept { return curr_size == 0; }
+
+        [[nodiscard]] constexpr size_type size() const noexcept { return curr_size; }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return N; }
+
+        // validated element access
+        constexpr bool test(size_type pos) const
+        {
+            validate_index(pos);
+            return bit(pos);
+        }
+
+        constexpr bool at(size_type pos) const { return test(pos); }
+
+        constexpr reference at(size_type pos)
+        {
+            validate_index(pos);
+            return (*this)[pos];
+        }
+
+        // non-validated element access
+        constexpr bool operator[](size_type pos) const { return bit(pos); }
+
+        constexpr reference operator[](size_type pos) { return reference(words_data + pos / bits_per_word, mask_of(pos)); }
+
+        constexpr bool front() const { return bit(0); }
+
+        constexpr reference front() { return (*this)[0]; }
+
+        constexpr bool back() const { return bit(curr_size - 1); }
+
+        constexpr reference back() { return (*this)[curr_size - 1]; }
+
+        // iterators
+        constexpr iterator begin() noexcept { return iterator(this, 0); }
+
+        constexpr riterator rbegin() noexcept { return riterator(end()); }
+
+        constexpr const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+        constexpr const_riterator rbegin() const noexcept { return const_riterator(end()); }
+
+        constexpr iterator end() noexcept { return iterator(this, curr_size); }
+
+        constexpr riterator rend() noexcept { return riterator(begin()); }
+
+        constexpr const_iterator end() const noexcept { return const_iterator(this, curr_size); }
+
+        constexpr const_riterator rend() const noexcept { return const_riterator(begin()); }
+
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+        constexpr const_riterator crbegin() const noexcept { return rbegin(); }
+
+        constexpr const_iterator cend() const noexcept { return end(); }
+
+        constexpr const_riterator crend() const noexcept { return rend(); }
+
+        // the underlying words, bit i lives in word i / 64 at position i % 64
+        constexpr std::span<const word_type, word_count> words() const noexcept { return std::span<const word_type, word_count>(words_data, word_count); }
+
+        // counting
+        constexpr size_type count() const noexcept
+        {
+            size_type set{0};
+            for (const word_type word : words_data)
+                set += static_cast<size_type>(std::popcount(word));
+            return set;
+        }
+
+        constexpr bool any() const noexcept
+        {
+            return std::any_of(std::begin(words_data), std::end(words_data), [](word_type word) { return word != 0; });
+        }
+
+        constexpr bool none() const noexcept { return !any(); }
+
+        constexpr bool all() const noexcept { return count() == curr_size; }
+
+        // searching, npos when there is no further set bit
+        constexpr size_type find_first() const noexcept
+        {
+            return find_from_word(0);
+        }
+
+        // first set bit after pos
+        constexpr size_type find_next(size_type pos) const noexcept
+        {
+            ++pos;
+            if (pos >= curr_size)
+                return npos;
+            const size_type idx{pos / bits_per_word};
+            const word_type rest{words_data[idx] & (~word_type{0} << (pos % bits_per_word))};
+            if (rest != 0)
+                return idx * bits_per_word + static_cast<size_type>(std::countr_zero(rest));
+            return find_from_word(idx + 1);
+        }
+
+        // mutating functions
+        // validated bit modification
+        constexpr static_bitvector &set(size_type pos, bool value = true)
+        {
+            validate_index(pos);
+            assign_bit(pos, value);
+            return *this;
+        }
+
+        constexpr static_bitvector &reset(size_type pos)
+        {
+            return set(pos, false);
+        }
+
+        constexpr static_bitvector &flip(size_type pos)
+        {
+            validate_index(pos);
+            words_data[pos / bits_per_word] ^= mask_of(pos);
+            return *this;
+        }
+
+        // whole vector modification, the size is kept
+        constexpr static_bitvector &set() noexcept
+        {
+            std::fill(std::begin(words_data), std::end(words_data), ~word_type{0});
+            clear_tail();
+            return *this;
+        }
+
+        constexpr static_bitvector &reset() noexcept
+        {
+            std::fill(std::begin(words_data), std::end(words_data), word_type{0});
+            return *this;
+        }
+
+        constexpr static_bitvector &flip() noexcept
+        {
+            for (word_type &word : words_data)
+                word = ~word;
+            clear_tail();
+            return *this;
+        }
+
+        // addition
+        constexpr void push_back(bool value)
+        {
+            if (curr_size >= N)
+                KSV_THROW(std::length_error("Reached max capacity."), "Reached max capacity.");
+            assign_bit(curr_size, value);
+            ++curr_size;
+        }
+
+        // removal
+        constexpr void pop_back()
+        {
+            --curr_size;
+            assign_bit(curr_size, false);
+        }
+
+        constexpr void clear() noexcept
+        {
+            reset();
+            curr_size = 0;
+        }
+
+        constexpr void resize(size_type count, bool value = false)
+        {
+            validate_count(count);
+            const size_type old_size{curr_size};
+            curr_size = static_cast<detail::size_for<N>>(count);
+            if (count < old_size)
+                clear_tail();
+            else if (value)
+                for (size_type i{old_size}; i < count; ++i)
+                    assign_bit(i, true);
+        }
+
+        // word-parallel bitwise operators, the shorter operand counts as
+        // padded with zero bits and the result has the longer size
+        constexpr static_bitvector &operator&=(const static_bitvector &other) noexcept
+        {
+            for (size_type i{0}; i < word_count; ++i)
+                words_data[i] &= other.words_data[i];
+            curr_size = std::max(curr_size, other.curr_size);
+            return *this;
+        }
+
+        constexpr static_bitvector &operator|=(const static_bitvector &other) noexcept
+        {
+            for (size_type i{0}; i < word_count; ++i)
+                words_data[i] |= other.words_data[i];
+            curr_size = std::max(curr_size, other.curr_size);
+            return *this;
+        }
+
+        constexpr static_bitvector &operator^=(const static_bitvector &other) noexcept
+        {
+            for (size_type i{0}; i < word_count; ++i)
+                words_data[i] ^= other.words_data[i];
+            curr_size = std::max(curr_size, other.curr_size);
+            return *this;
+        }
+
+        friend constexpr static_bitvector operator&(static_bitvector lhs, const static_bitvector &rhs) noexcept { return lhs &= rhs; }
+
+        friend constexpr static_bitvector operator|(static_bitvector lhs, const static_bitvector &rhs) noexcept { return lhs |= rhs; }
+
+        friend constexpr static_bitvector operator^(static_bitvector lhs, const static_bitvector &rhs) noexcept { return lhs ^= rhs; }
+
+        // swap
+        friend constexpr void swap(static_bitvector &lhs, static_bitvector &rhs) noexcept
+        {
+            std::swap(lhs.words_data, rhs.words_data);
+            std::swap(lhs.curr_size, rhs.curr_size);
+        }
+
+        // comparison operators
+        friend constexpr bool operator==(const static_bitvector &lhs, const static_bitvector &rhs) noexcept
+        {
+            return lhs.curr_size == rhs.curr_size && std::equal(std::begin(lhs.words_data), std::end(lhs.words_data), std::begin(rhs.words_data));
+        }
+
+        // proxy for a single bit, assignable from bool and convertible to it
+        class reference
+        {
+        public:
+            constexpr reference &operator=(bool value) noexcept
+            {
+                std::as_const(*this) = value;
+                return *this;
+            }
+
+            constexpr reference &operator=(const reference &other) noexcept
+            {
+                return *this = static_cast<bool>(other);
+            }
+
+            // assigning through a const proxy still writes the referenced bit
+            constexpr const reference &operator=(bool value) const noexcept
+            {
+                *word = value ? (*word | mask) : (*word & ~mask);
+                return *this;
+            }
+
+            constexpr operator bool() const noexcept { return (*word & mask) != 0; }
+
+            constexpr bool operator~() const noexcept { return !static_cast<bool>(*this); }
+
+            constexpr reference &flip() noexcept
+            {
+                *word ^= mask;
+                return *this;
+            }
+
+            friend constexpr void swap(reference lhs, reference rhs) noexcept
+            {
+                const bool tmp{lhs};
+                lhs = static_cast<bool>(rhs);
+                rhs = tmp;
+            }
+
+        private:
+            friend class static_bitvector;
+
+            constexpr reference(word_type *target, word_type target_mask) noexcept : word(target), mask(target_mask) {}
+
+            word_type *word;
+            word_type mask;
+        };
+
+    private:
+        // instance fields
+        word_type words_data[word_count == 0 ? 1 : word_count]{};
+        detail::size_for<N> curr_size{0};
+
+        static constexpr word_type mask_of(size_type pos) noexcept { return word_type{1} << (pos % bits_per_word); }
+
+        constexpr bool bit(size_type pos) const noexcept { return (words_data[pos / bits_per_word] & mask_of(pos)) != 0; }
+
+        constexpr void assign_bit(size_type pos, bool value) noexcept
+        {
+            // branch free: clear the bit, then or in value
+            word_type &word{words_data[pos / bits_per_word]};
+            word = (word & ~mask_of(pos)) | (static_cast<word_type>(value) << (pos % bits_per_word));
+        }
+
+        // zeroes every bit past size() to restore the invariant
+        constexpr void clear_tail() noexcept
+        {
+            const size_type idx{curr_size / bits_per_word};
+            if (idx >= word_count)
+                return;
+            words_data[idx] &= (word_type{1} << (curr_size % bits_per_word)) - 1;
+            std::fill(std::begin(words_data) + idx + 1, std::end(words_data), word_type{0});
+        }
+
+        constexpr size_type find_from_word(size_type idx) const noexcept
+        {
+            for (; idx < word_count; ++idx)
+                if (words_data[idx] != 0)
+                    return idx * bits_per_word + static_cast<size_type>(std::countr_zero(words_data[idx]));
+            return npos;
+        }
+
+        // methods for validation
+        constexpr void validate_index(size_type index) const
+        {
+            if (index >= curr_size)
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+        }
+
+        constexpr void validate_count(size_type count) const
+        {
+            if (count > N)
+                KSV_THROW(std::bad_alloc(), "Exceeded capacity.");
+        }
+
+        // random access iterator holding the index of a bit
+        template<bool Const>
+        class basic_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+            using value_type = bool;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::conditional_t<Const, bool, static_bitvector::reference>;
+
+            constexpr basic_iterator() noexcept = default;
+
+            // non-const to const conversion
+            template<bool OtherConst>
+                requires(Const && !OtherConst)
+            constexpr basic_iterator(const basic_iterator<OtherConst> &other) noexcept : owner(other.owner), idx(other.idx)
+            {}
+
+            constexpr reference operator*() const { return (*owner)[idx]; }
+
+            constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+            constexpr basic_iterator &operator++() noexcept
+            {
+                ++idx;
+                return *this;
+            }
+
+            constexpr basic_iterator operator++(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                ++idx;
+                return tmp;
+            }
+
+            constexpr basic_iterator &operator--() noexcept
+            {
+                --idx;
+                return *this;
+            }
+
+            constexpr basic_iterator operator--(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                --idx;
+                return tmp;
+            }
+
+            constexpr basic_iterator &operator+=(difference_type n) noexcept
+            {
+                idx = static_cast<size_type>(static_cast<difference_type>(idx) + n);
+                return *this;
+            }
+
+            constexpr basic_iterator &operator-=(difference_type n) noexcept
+            {
+                return *this += -n;
+            }
+
+            friend constexpr basic_iterator operator+(basic_iterator iter, difference_type n) noexcept { return iter += n; }
+
+            friend constexpr basic_iterator operator+(difference_type n, basic_iterator iter) noexcept { return iter += n; }
+
+            friend constexpr basic_iterator operator-(basic_iterator iter, difference_type n) noexcept { return iter -= n; }
+
+            friend constexpr difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs) noexcept
+            {
+                return static_cast<difference_type>(lhs.idx) - static_cast<difference_type>(rhs.idx);
+            }
+
+            friend constexpr bool operator==(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx == rhs.idx; }
+
+            friend constexpr std::strong_ordering operator<=>(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx <=> rhs.idx; }
+
+        private:
+            friend class static_bitvector;
+            friend class basic_iterator<!Const>;
+
+            using owner_type = std::conditional_t<Const, const static_bitvector, static_bitvector>;
+
+            constexpr basic_iterator(owner_type *vec, size_type pos) noexcept : owner(vec), idx(pos) {}
+
+            owner_type *owner{nullptr};
+            size_type idx{0};
+        };
+    };
+
+}// namespace ksv
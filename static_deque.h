@@ -0,0 +1,475 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    // Fixed-capacity double-ended queue over a circular buffer of N elements.
+    // With OverwriteOldest, adding to a full deque drops the element at the
+    // opposite end instead of failing.
+    template<typename T, std::size_t N, bool OverwriteOldest = false>
+    class static_deque
+    {
+        static_assert(N > 0, "static_deque needs a non-zero capacity.");
+
+        template<bool Const>
+        class basic_iterator;
+
+    public:
+        // type aliases
+        using value_type = T;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using riterator = std::reverse_iterator<iterator>;
+        using const_riterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        // ctors
+        static_deque() noexcept = default;
+
+        template<std::input_iterator Iter>
+        static_deque(Iter begin, Iter end)
+        {
+            KSV_TRY
+            {
+                for (; begin != end; ++begin)
+                    emplace_back(*begin);
+            }
+            KSV_CATCH_ALL
+            {
+                clear();
+                KSV_RETHROW;
+            }
+        }
+
+        static_deque(std::initializer_list<T> list) : static_deque(std::begin(list), std::end(list)) {}
+
+        static_deque(const static_deque &other)
+        {
+            if constexpr (trivially_copyable)
+            {
+                copy_linear(other);
+                return;
+            }
+
+            KSV_TRY
+            {
+                for (const auto &elem : other)
+                    eb_internal(elem);
+            }
+            KSV_CATCH_ALL
+            {
+                clear();
+                KSV_RETHROW;
+            }
+        }
+
+        static_deque(static_deque &&other) noexcept(trivially_relocatable || std::is_nothrow_move_constructible_v<T>)
+        {
+            take_elements(other);
+        }
+
+        // assignments
+        static_deque &operator=(const static_deque &other)
+        {
+            if (this != &other)
+            {
+                static_deque tmp{other};
+                clear();
+                take_elements(tmp);
+            }
+            return *this;
+        }
+
+        static_deque &operator=(static_deque &&other) noexcept(trivially_relocatable || std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this != &other)
+            {
+                clear();
+                take_elements(other);
+            }
+            return *this;
+        }
+
+        // dtor
+        ~static_deque()
+        {
+            clear();
+        }
+
+        // non-mutating functions
+        [[nodiscard]] bool empty() const noexcept { return curr_size == 0; }
+
+        [[nodiscard]] bool full() const noexcept { return curr_size == N; }
+
+        [[nodiscard]] size_type size() const noexcept { return curr_size; }
+
+        [[nodiscard]] size_type capacity() const noexcept { return N; }
+
+        // validated element access
+        const_reference at(size_type pos) const
+        {
+            validate_index(pos);
+            return (*this)[pos];
+        }
+
+        reference at(size_type pos)
+        {
+            validate_index(pos);
+            return (*this)[pos];
+        }
+
+        // non-validated element access
+        const_reference operator[](size_type pos) const { return *slot(pos); }
+
+        reference operator[](size_type pos) { return *slot(pos); }
+
+        const_reference front() const { return *slot(0); }
+
+        reference front() { return *slot(0); }
+
+        const_reference back() const { return *slot(curr_size - 1); }
+
+        reference back() { return *slot(curr_size - 1); }
+
+        // iterators
+        iterator begin() noexcept { return iterator(this, 0); }
+
+        riterator rbegin() noexcept { return riterator(end()); }
+
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+        const_riterator rbegin() const noexcept { return const_riterator(end()); }
+
+        iterator end() noexcept { return iterator(this, curr_size); }
+
+        riterator rend() noexcept { return riterator(begin()); }
+
+        const_iterator end() const noexcept { return const_iterator(this, curr_size); }
+
+        const_riterator rend() const noexcept { return const_riterator(begin()); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        const_riterator crbegin() const noexcept { return rbegin(); }
+
+        const_iterator cend() const noexcept { return end(); }
+
+        const_riterator crend() const noexcept { return rend(); }
+
+        // underlying buffer access, the elements in order as at most two contiguous chunks
+        std::pair<std::span<T>, std::span<T>> as_spans() noexcept
+        {
+            const size_type first_len{std::min<size_type>(curr_size, N - head)};
+            return {std::span<T>(storage.ptr() + head, first_len), std::span<T>(storage.ptr(), curr_size - first_len)};
+        }
+
+        std::pair<std::span<const T>, std::span<const T>> as_spans() const noexcept
+        {
+            const size_type first_len{std::min<size_type>(curr_size, N - head)};
+            return {std::span<const T>(storage.ptr() + head, first_len), std::span<const T>(storage.ptr(), curr_size - first_len)};
+        }
+
+        // mutating functions
+        // addition
+        void push_back(const_reference value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(value_type &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args &&...args)
+        {
+            if (full())
+            {
+                if constexpr (OverwriteOldest)
+                {
+                    // args may refer to the element being dropped
+                    T value(std::forward<Args>(args)...);
+                    pop_front();
+                    eb_internal(std::move(value));
+                    return back();
+                }
+                else
+                    validate_not_full();
+            }
+            eb_internal(std::forward<Args>(args)...);
+            return back();
+        }
+
+        void push_front(const_reference value)
+        {
+            emplace_front(value);
+        }
+
+        void push_front(value_type &&value)
+        {
+            emplace_front(std::move(value));
+        }
+
+        template<typename... Args>
+        reference emplace_front(Args &&...args)
+        {
+            if (full())
+            {
+                if constexpr (OverwriteOldest)
+                {
+                    T value(std::forward<Args>(args)...);
+                    pop_back();
+                    ef_internal(std::move(value));
+                    return front();
+                }
+                else
+                    validate_not_full();
+            }
+            ef_internal(std::forward<Args>(args)...);
+            return front();
+        }
+
+        // removal
+        void pop_back()
+        {
+            --curr_size;
+            std::destroy_at(slot(curr_size));
+        }
+
+        void pop_front()
+        {
+            std::destroy_at(slot(0));
+            head = static_cast<index_type>(wrap(head + 1));
+            --curr_size;
+        }
+
+        void clear() noexcept
+        {
+            if constexpr (!trivially_copyable)
+                while (curr_size != 0)
+                    pop_back();
+            curr_size = 0;
+            head = 0;
+        }
+
+        // swap
+        friend void swap(static_deque &lhs, static_deque &rhs) noexcept(std::is_nothrow_move_constructible_v<static_deque>)
+        {
+            static_deque tmp{std::move(lhs)};
+            lhs = std::move(rhs);
+            rhs = std::move(tmp);
+        }
+
+        // comparison operators
+        friend bool operator==(const static_deque &lhs, const static_deque &rhs)
+        {
+            return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        // ordered like std::vector, by T's <=> or else by its <
+        friend auto operator<=>(const static_deque &lhs, const static_deque &rhs)
+        {
+            return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), detail::synth_three_way{});
+        }
+
+    private:
+        using index_type = detail::size_for<N>;
+
+        // instance fields
+        // element i lives in slot wrap(head + i)
+        detail::byte_storage<T, N> storage;
+        index_type head{0};
+        index_type curr_size{0};
+
+        // element types that may be copied as raw bytes and need no destruction
+        static constexpr bool trivially_copyable = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+
+        // element types that may be moved as raw bytes
+        static constexpr bool trivially_relocatable = is_trivially_relocatable_v<T>;
+
+        // index arithmetic is a mask for power-of-two capacities
+        static constexpr bool power_of_two = (N & (N - 1)) == 0;
+
+        // maps a position in [0, 2N) onto the buffer
+        static constexpr size_type wrap(size_type pos) noexcept
+        {
+            if constexpr (power_of_two)
+                return pos & (N - 1);
+            else
+                return pos >= N ? pos - N : pos;
+        }
+
+        pointer slot(size_type idx) noexcept { return storage.ptr() + wrap(head + idx); }
+
+        const_pointer slot(size_type idx) const noexcept { return storage.ptr() + wrap(head + idx); }
+
+        // methods for validation
+        void validate_index(size_type index) const
+        {
+            if (index >= curr_size)
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+        }
+
+        void validate_not_full() const
+        {
+            if (full())
+                KSV_THROW(std::length_error("Reached max capacity."), "Reached max capacity.");
+        }
+
+        // copies the elements of other to the start of the buffer, at most two memcpy calls
+        void copy_linear(const static_deque &other) noexcept
+        {
+            const auto [first, second]{other.as_spans()};
+            std::memcpy(static_cast<void *>(storage.ptr()), first.data(), first.size_bytes());
+            std::memcpy(static_cast<void *>(storage.ptr() + first.size()), second.data(), second.size_bytes());
+            head = 0;
+            curr_size = other.curr_size;
+        }
+
+        // adopts the elements of other into this empty deque, other is left empty
+        void take_elements(static_deque &other) noexcept(trivially_relocatable || std::is_nothrow_move_constructible_v<T>)
+        {
+            if constexpr (trivially_relocatable)
+                copy_linear(other);
+            else
+                for (auto &elem : other)
+                    eb_internal(std::move(elem));
+            if constexpr (!trivially_relocatable)
+                other.clear();
+            other.curr_size = 0;
+            other.head = 0;
+        }
+
+        template<typename... Args>
+        void eb_internal(Args &&...args)
+        {
+            std::construct_at(slot(curr_size), std::forward<Args>(args)...);
+            ++curr_size;
+        }
+
+        template<typename... Args>
+        void ef_internal(Args &&...args)
+        {
+            const auto new_head{static_cast<index_type>(wrap(head + N - 1))};
+            std::construct_at(storage.ptr() + new_head, std::forward<Args>(args)...);
+            head = new_head;
+            ++curr_size;
+        }
+
+        // random access iterator holding the logical index of an element
+        template<bool Const>
+        class basic_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T *, T *>;
+            using reference = std::conditional_t<Const, const T &, T &>;
+
+            basic_iterator() noexcept = default;
+
+            // non-const to const conversion
+            template<bool OtherConst>
+                requires(Const && !OtherConst)
+            basic_iterator(const basic_iterator<OtherConst> &other) noexcept : owner(other.owner), idx(other.idx)
+            {}
+
+            reference operator*() const { return (*owner)[idx]; }
+
+            pointer operator->() const { return std::addressof(**this); }
+
+            reference operator[](difference_type n) const { return (*owner)[static_cast<size_type>(static_cast<difference_type>(idx) + n)]; }
+
+            basic_iterator &operator++() noexcept
+            {
+                ++idx;
+                return *this;
+            }
+
+            basic_iterator operator++(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                ++idx;
+                return tmp;
+            }
+
+            basic_iterator &operator--() noexcept
+            {
+                --idx;
+                return *this;
+            }
+
+            basic_iterator operator--(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                --idx;
+                return tmp;
+            }
+
+            basic_iterator &operator+=(difference_type n) noexcept
+            {
+                idx = static_cast<size_type>(static_cast<difference_type>(idx) + n);
+                return *this;
+            }
+
+            basic_iterator &operator-=(difference_type n) noexcept
+            {
+                return *this += -n;
+            }
+
+            friend basic_iterator operator+(basic_iterator iter, difference_type n) noexcept { return iter += n; }
+
+            friend basic_iterator operator+(difference_type n, basic_iterator iter) noexcept { return iter += n; }
+
+            friend basic_iterator operator-(basic_iterator iter, difference_type n) noexcept { return iter -= n; }
+
+            friend difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs) noexcept
+            {
+                return static_cast<difference_type>(lhs.idx) - static_cast<difference_type>(rhs.idx);
+            }
+
+            friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx == rhs.idx; }
+
+            friend std::strong_ordering operator<=>(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx <=> rhs.idx; }
+
+        private:
+            friend class static_deque;
+            friend class basic_iterator<!Const>;
+
+            using owner_type = std::conditional_t<Const, const static_deque, static_deque>;
+
+            basic_iterator(owner_type *deque, size_type pos) noexcept : owner(deque), idx(pos) {}
+
+            owner_type *owner{nullptr};
+            size_type idx{0};
+        };
+    };
+
+    // fixed-capacity circular buffer that overwrites its oldest element when full
+    template<typename T, std::size_t N>
+    using ring_buffer = static_deque<T, N, true>;
+
+}// namespace ksv
@@ -0,0 +1,731 @@
+#pragma once
+
+#include "simd_detail.h"
+#include "static_vector.h"
+
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    // tag for input that is already sorted and free of duplicate keys
+#if defined(__cpp_lib_flat_map)
+    using std::sorted_unique;
+    using std::sorted_unique_t;
+#else
+    struct sorted_unique_t
+    {
+        explicit sorted_unique_t() = default;
+    };
+
+    inline constexpr sorted_unique_t sorted_unique{};
+#endif
+
+    namespace detail
+    {
+        // comparators that accept keys of other types than the stored one
+        template<typename Compare>
+        concept transparent_compare = requires { typename Compare::is_transparent; };
+
+        // sorted key ranges up to this many bytes are scanned linearly
+        inline constexpr std::size_t linear_search_bytes{256};
+
+#if defined(__SSE2__)
+        // number of keys below key, or not above it for Upper
+        template<bool Upper, typename K>
+        inline std::size_t count_below_simd(const K *keys, std::size_t count, K key) noexcept
+        {
+            constexpr std::size_t lanes{16 / sizeof(K)};
+            constexpr std::size_t bits_per_lane{std::is_same_v<K, float> || sizeof(K) == 4 ? 1 : sizeof(K)};
+            const __m128i needle{broadcast(key)};
+            std::size_t below{0};
+            std::size_t i{0};
+            // the keys are sorted, so the lanes below key are a prefix of each
+            // mask and counting them is a bit scan, popcount is a libgcc call
+            // without -mpopcnt
+            for (; i + lanes <= count; i += lanes)
+            {
+                const __m128i block{_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i))};
+                if constexpr (Upper)
+                    below += static_cast<std::size_t>(std::countr_zero(greater_mask<K>(block, needle) | (1u << (lanes * bits_per_lane)))) / bits_per_lane;
+                else
+                    below += static_cast<std::size_t>(std::countr_one(greater_mask<K>(needle, block))) / bits_per_lane;
+            }
+            for (; i < count; ++i)
+                below += Upper ? !(key < keys[i]) : keys[i] < key;
+            return below;
+        }
+#endif
+
+        // index of the first key not ordered before key (lower bound), or
+        // after key (upper bound), in the sorted range [keys, keys + count)
+        template<bool Upper, typename K, typename Key, typename Compare>
+        constexpr std::size_t sorted_bound(const K *keys, std::size_t count, const Key &key, const Compare &comp)
+        {
+            const auto below{[&](const K &elem) -> bool {
+                if constexpr (Upper)
+                    return !comp(key, elem);
+                else
+                    return comp(elem, key);
+            }};
+
+            if (count * sizeof(K) <= linear_search_bytes)
+            {
+#if defined(__SSE2__)
+                if constexpr (simd_searchable<K, Key, Compare>)
+                    if (!std::is_constant_evaluated())
+                        return count_below_simd<Upper>(keys, count, key);
+#endif
+                // sorted, so counting the keys below is the bound, without branches
+                std::size_t idx{0};
+                for (std::size_t i{0}; i < count; ++i)
+                    idx += below(keys[i]);
+                return idx;
+            }
+
+            // halves the range with a conditional move instead of a branch
+            const K *base{keys};
+            while (count > 1)
+            {
+                const std::size_t half{count / 2};
+                base += below(base[half - 1]) ? half : 0;
+                count -= half;
+            }
+            return static_cast<std::size_t>(base - keys) + (count == 1 && below(*base));
+        }
+
+        // merges sorted staged elements without duplicate keys into the sorted
+        // elements of dest, dropping those whose key dest already holds. An
+        // element is one entry in each of the columns, static_vectors whose
+        // first one holds the keys. Running out of capacity leaves dest
+        // unchanged, otherwise every element is moved once; if a move throws
+        // half way dest is cleared.
+        template<typename Compare, typename... Columns>
+        constexpr void merge_staged(const Compare &comp, std::tuple<Columns &...> dest, std::tuple<Columns &...> staged)
+        {
+            // runs op(dest column, staged column) for every column
+            const auto each{[&dest, &staged](auto op) {
+                [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    (op(std::get<Is>(dest), std::get<Is>(staged)), ...);
+                }(std::index_sequence_for<Columns...>{});
+            }};
+            auto &keys{std::get<0>(dest)};
+            auto &staged_keys{std::get<0>(staged)};
+
+            // drop the staged keys already present
+            const std::size_t old_size{keys.size()};
+            std::size_t kept{0};
+            for (std::size_t i{0}, j{0}; j < staged_keys.size(); ++j)
+            {
+                while (i < old_size && comp(keys[i], staged_keys[j]))
+                    ++i;
+                if (i < old_size && !comp(staged_keys[j], keys[i]))
+                    continue;
+                if (kept != j)
+                    each([kept, j](auto &, auto &from) { from[kept] = std::move(from[j]); });
+                ++kept;
+            }
+            if (kept > keys.capacity() - old_size)
+                KSV_THROW(std::bad_alloc(), "Exceeded capacity.");
+
+            KSV_TRY
+            {
+                // the kept largest elements of the result go into new slots at the
+                // back, found by walking both sequences backwards without moving
+                std::size_t i{old_size};
+                std::size_t j{kept};
+                for (std::size_t placed{0}; placed < kept; ++placed)
+                {
+                    if (j > 0 && (i == 0 || comp(keys[i - 1], staged_keys[j - 1])))
+                        --j;
+                    else
+                        --i;
+                }
+                for (std::size_t from_old{i}, from_staged{j}; from_old < old_size || from_staged < kept;)
+                {
+                    if (from_staged == kept || (from_old < old_size && comp(keys[from_old], staged_keys[from_staged])))
+                    {
+                        each([from_old](auto &to, auto &) { to.emplace_back(std::move(to[from_old])); });
+                        ++from_old;
+                    }
+                    else
+                    {
+                        each([from_staged](auto &to, auto &from) { to.emplace_back(std::move(from[from_staged])); });
+                        ++from_staged;
+                    }
+                }
+
+                // the remaining i + j elements fill [0, old_size) back to front,
+                // the write position never passes an unread old element
+                for (std::size_t out{old_size}; j > 0;)
+                {
+                    --out;
+                    if (i > 0 && comp(staged_keys[j - 1], keys[i - 1]))
+                    {
+                        --i;
+                        each([out, i](auto &to, auto &) { to[out] = std::move(to[i]); });
+                    }
+                    else
+                    {
+                        --j;
+                        each([out, j](auto &to, auto &from) { to[out] = std::move(from[j]); });
+                    }
+                }
+            }
+            KSV_CATCH_ALL
+            {
+                each([](auto &to, auto &) { to.clear(); });
+                KSV_RETHROW;
+            }
+        }
+
+        // pair of references to a key and its value, what static_flat_map
+        // iterators yield; unlike a std::pair of references in C++20 it has
+        // a common reference with the std::pair value_type (see below), so
+        // the iterators model std::random_access_iterator
+        template<typename K, typename V>
+        struct pair_ref : std::pair<K &, V &>
+        {
+            constexpr pair_ref(K &key, V &value) noexcept : std::pair<K &, V &>(key, value) {}
+
+            template<typename OtherV>
+                requires std::is_convertible_v<OtherV &, V &>
+            constexpr pair_ref(const pair_ref<K, OtherV> &other) noexcept : std::pair<K &, V &>(other.first, other.second)
+            {}
+
+            template<typename OtherK, typename OtherV>
+                requires std::is_convertible_v<OtherK &, K &> && std::is_convertible_v<OtherV &, V &>
+            constexpr pair_ref(std::pair<OtherK, OtherV> &elem) noexcept : std::pair<K &, V &>(elem.first, elem.second)
+            {}
+
+            template<typename OtherK, typename OtherV>
+                requires std::is_convertible_v<const OtherK &, K &> && std::is_convertible_v<const OtherV &, V &>
+            constexpr pair_ref(const std::pair<OtherK, OtherV> &elem) noexcept : std::pair<K &, V &>(elem.first, elem.second)
+            {}
+        };
+    }// namespace detail
+
+    // Sorted associative container of up to N unique keys, with keys and
+    // values in two static_vectors so that searches only touch the keys.
+    // Iterators are invalidated by every insertion and erasure.
+    template<typename K, typename V, std::size_t N, typename Compare = std::less<K>>
+    class static_flat_map
+    {
+        template<bool Const>
+        class basic_iterator;
+
+    public:
+        // type aliases
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<K, V>;
+        using key_compare = Compare;
+        using reference = detail::pair_ref<const K, V>;
+        using const_reference = detail::pair_ref<const K, const V>;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using riterator = std::reverse_iterator<iterator>;
+        using const_riterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using key_container_type = static_vector<K, N>;
+        using mapped_container_type = static_vector<V, N>;
+
+        // ctors
+        constexpr static_flat_map() = default;
+
+        constexpr explicit static_flat_map(const Compare &compare) : comp(compare) {}
+
+        template<std::input_iterator Iter>
+        constexpr static_flat_map(Iter first, Iter last)
+        {
+            insert(first, last);
+        }
+
+        template<std::input_iterator Iter>
+        constexpr static_flat_map(sorted_unique_t, Iter first, Iter last)
+        {
+            insert(sorted_unique, first, last);
+        }
+
+        constexpr static_flat_map(std::initializer_list<value_type> list) : static_flat_map(list.begin(), list.end()) {}
+
+        constexpr static_flat_map(sorted_unique_t, std::initializer_list<value_type> list) : static_flat_map(sorted_unique, list.begin(), list.end()) {}
+
+        // non-mutating functions
+        [[nodiscard]] constexpr bool empty() const { return key_list.empty(); }
+
+        [[nodiscard]] constexpr size_type size() const { return key_list.size(); }
+
+        [[nodiscard]] constexpr size_type capacity() const { return N; }
+
+        constexpr const key_container_type &keys() const noexcept { return key_list; }
+
+        constexpr const mapped_container_type &values() const noexcept { return value_list; }
+
+        constexpr key_compare key_comp() const { return comp; }
+
+        // iterators
+        constexpr iterator begin() { return iterator(this, 0); }
+
+        constexpr riterator rbegin() { return riterator(end()); }
+
+        constexpr const_iterator begin() const { return const_iterator(this, 0); }
+
+        constexpr const_riterator rbegin() const { return const_riterator(end()); }
+
+        constexpr iterator end() { return iterator(this, size()); }
+
+        constexpr riterator rend() { return riterator(begin()); }
+
+        constexpr const_iterator end() const { return const_iterator(this, size()); }
+
+        constexpr const_riterator rend() const { return const_riterator(begin()); }
+
+        constexpr const_iterator cbegin() const { return begin(); }
+
+        constexpr const_riterator crbegin() const { return rbegin(); }
+
+        constexpr const_iterator cend() const { return end(); }
+
+        constexpr const_riterator crend() const { return rend(); }
+
+        // lookup, the Key overloads only take part with a transparent comparator
+        constexpr iterator find(const K &key) { return iterator(this, find_index(key)); }
+
+        constexpr const_iterator find(const K &key) const { return const_iterator(this, find_index(key)); }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr iterator find(const Key &key)
+        {
+            return iterator(this, find_index(key));
+        }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr const_iterator find(const Key &key) const
+        {
+            return const_iterator(this, find_index(key));
+        }
+
+        constexpr bool contains(const K &key) const { return find_index(key) != size(); }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr bool contains(const Key &key) const
+        {
+            return find_index(key) != size();
+        }
+
+        constexpr size_type count(const K &key) const { return contains(key) ? 1 : 0; }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr size_type count(const Key &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        constexpr iterator lower_bound(const K &key) { return iterator(this, lower_index(key)); }
+
+        constexpr const_iterator lower_bound(const K &key) const { return const_iterator(this, lower_index(key)); }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr iterator lower_bound(const Key &key)
+        {
+            return iterator(this, lower_index(key));
+        }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr const_iterator lower_bound(const Key &key) const
+        {
+            return const_iterator(this, lower_index(key));
+        }
+
+        constexpr iterator upper_bound(const K &key) { return iterator(this, upper_index(key)); }
+
+        constexpr const_iterator upper_bound(const K &key) const { return const_iterator(this, upper_index(key)); }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr iterator upper_bound(const Key &key)
+        {
+            return iterator(this, upper_index(key));
+        }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr const_iterator upper_bound(const Key &key) const
+        {
+            return const_iterator(this, upper_index(key));
+        }
+
+        // validated element access
+        constexpr const V &at(const K &key) const
+        {
+            return value_list[validated_index(key)];
+        }
+
+        constexpr V &at(const K &key)
+        {
+            return value_list[validated_index(key)];
+        }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr const V &at(const Key &key) const
+        {
+            return value_list[validated_index(key)];
+        }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr V &at(const Key &key)
+        {
+            return value_list[validated_index(key)];
+        }
+
+        // inserting element access
+        constexpr V &operator[](const K &key) { return (*try_emplace(key).first).second; }
+
+        constexpr V &operator[](K &&key) { return (*try_emplace(std::move(key)).first).second; }
+
+        // mutating functions
+        // addition
+        template<typename... Args>
+        constexpr std::pair<iterator, bool> try_emplace(const K &key, Args &&...args)
+        {
+            return try_emplace_internal(key, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        constexpr std::pair<iterator, bool> try_emplace(K &&key, Args &&...args)
+        {
+            return try_emplace_internal(std::move(key), std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        constexpr std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            value_type elem(std::forward<Args>(args)...);
+            return try_emplace_internal(std::move(elem.first), std::move(elem.second));
+        }
+
+        constexpr std::pair<iterator, bool> insert(const value_type &elem)
+        {
+            return try_emplace_internal(elem.first, elem.second);
+        }
+
+        constexpr std::pair<iterator, bool> insert(value_type &&elem)
+        {
+            return try_emplace_internal(std::move(elem.first), std::move(elem.second));
+        }
+
+        template<typename Obj>
+        constexpr std::pair<iterator, bool> insert_or_assign(const K &key, Obj &&obj)
+        {
+            auto result{try_emplace_internal(key, std::forward<Obj>(obj))};
+            if (!result.second)
+                value_list[result.first.idx] = std::forward<Obj>(obj);
+            return result;
+        }
+
+        template<typename Obj>
+        constexpr std::pair<iterator, bool> insert_or_assign(K &&key, Obj &&obj)
+        {
+            auto result{try_emplace_internal(std::move(key), std::forward<Obj>(obj))};
+            if (!result.second)
+                value_list[result.first.idx] = std::forward<Obj>(obj);
+            return result;
+        }
+
+        template<std::input_iterator Iter>
+        constexpr void insert(Iter first, Iter last)
+        {
+            for (; first != last; ++first)
+                emplace(*first);
+        }
+
+        // merges sorted input without duplicate keys, keys already present
+        // are kept. The input is staged first, so running out of capacity
+        // leaves the map unchanged; afterwards every element is moved once.
+        template<std::input_iterator Iter>
+        constexpr void insert(sorted_unique_t, Iter first, Iter last)
+        {
+            key_container_type staged_keys;
+            mapped_container_type staged_values;
+            for (; first != last; ++first)
+            {
+                auto &&elem{*first};
+                staged_keys.emplace_back(std::get<0>(std::forward<decltype(elem)>(elem)));
+                staged_values.emplace_back(std::get<1>(std::forward<decltype(elem)>(elem)));
+            }
+            detail::merge_staged(comp, std::tie(key_list, value_list), std::tie(staged_keys, staged_values));
+        }
+
+        constexpr void insert(std::initializer_list<value_type> list)
+        {
+            insert(list.begin(), list.end());
+        }
+
+        constexpr void insert(sorted_unique_t, std::initializer_list<value_type> list)
+        {
+            insert(sorted_unique, list.begin(), list.end());
+        }
+
+        // removal
+        constexpr iterator erase(const_iterator pos)
+        {
+            key_list.erase(key_list.begin() + pos.idx);
+            value_list.erase(value_list.begin() + pos.idx);
+            return iterator(this, pos.idx);
+        }
+
+        constexpr size_type erase(const K &key)
+        {
+            return erase_key(key);
+        }
+
+        // like std::map, iterators always select the positional erase
+        template<typename Key>
+            requires detail::transparent_compare<Compare> && (!std::is_convertible_v<const Key &, iterator>) && (!std::is_convertible_v<const Key &, const_iterator>)
+        constexpr size_type erase(const Key &key)
+        {
+            return erase_key(key);
+        }
+
+        constexpr void clear()
+        {
+            key_list.clear();
+            value_list.clear();
+        }
+
+        // swap
+        friend constexpr void swap(static_flat_map &lhs, static_flat_map &rhs)
+        {
+            using std::swap;
+            swap(lhs.key_list, rhs.key_list);
+            swap(lhs.value_list, rhs.value_list);
+            swap(lhs.comp, rhs.comp);
+        }
+
+        // comparison operators
+        friend constexpr bool operator==(const static_flat_map &lhs, const static_flat_map &rhs)
+        {
+            return lhs.key_list == rhs.key_list && lhs.value_list == rhs.value_list;
+        }
+
+        friend constexpr bool operator!=(const static_flat_map &lhs, const static_flat_map &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        // instance fields
+        key_container_type key_list;
+        mapped_container_type value_list;
+        [[no_unique_address]] Compare comp;
+
+        template<typename Key>
+        constexpr size_type lower_index(const Key &key) const
+        {
+            return detail::sorted_bound<false>(key_list.data(), key_list.size(), key, comp);
+        }
+
+        template<typename Key>
+        constexpr size_type upper_index(const Key &key) const
+        {
+            return detail::sorted_bound<true>(key_list.data(), key_list.size(), key, comp);
+        }
+
+        // index of key, or size() when absent
+        template<typename Key>
+        constexpr size_type find_index(const Key &key) const
+        {
+            const size_type idx{lower_index(key)};
+            return idx != size() && !comp(key, key_list[idx]) ? idx : size();
+        }
+
+        // methods for validation
+        template<typename Key>
+        constexpr size_type validated_index(const Key &key) const
+        {
+            const size_type idx{find_index(key)};
+            if (idx == size())
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+            return idx;
+        }
+
+        template<typename Key>
+        constexpr size_type erase_key(const Key &key)
+        {
+            const size_type idx{find_index(key)};
+            if (idx == size())
+                return 0;
+            erase(const_iterator(this, idx));
+            return 1;
+        }
+
+        template<typename KeyArg, typename... Args>
+        constexpr std::pair<iterator, bool> try_emplace_internal(KeyArg &&key, Args &&...args)
+        {
+            const size_type idx{lower_index(key)};
+            if (idx != size() && !comp(key, key_list[idx]))
+                return {iterator(this, idx), false};
+
+            key_list.emplace(key_list.begin() + idx, std::forward<KeyArg>(key));
+            KSV_TRY
+            {
+                value_list.emplace(value_list.begin() + idx, std::forward<Args>(args)...);
+            }
+            KSV_CATCH_ALL
+            {
+                key_list.erase(key_list.begin() + idx);
+                KSV_RETHROW;
+            }
+            return {iterator(this, idx), true};
+        }
+
+        // random access iterator holding the index of an element,
+        // dereferencing yields a pair of references into both containers
+        template<bool Const>
+        class basic_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+            using value_type = std::pair<K, V>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const_reference, static_flat_map::reference>;
+
+            // operator-> has to return something that owns the pair of references
+            struct pointer
+            {
+                reference ref;
+
+                constexpr const reference *operator->() const noexcept { return std::addressof(ref); }
+            };
+
+            constexpr basic_iterator() noexcept = default;
+
+            // non-const to const conversion
+            template<bool OtherConst>
+                requires(Const && !OtherConst)
+            constexpr basic_iterator(const basic_iterator<OtherConst> &other) noexcept : owner(other.owner), idx(other.idx)
+            {}
+
+            constexpr reference operator*() const { return reference(owner->key_list[idx], owner->value_list[idx]); }
+
+            constexpr pointer operator->() const { return pointer{**this}; }
+
+            constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+            constexpr basic_iterator &operator++() noexcept
+            {
+                ++idx;
+                return *this;
+            }
+
+            constexpr basic_iterator operator++(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                ++idx;
+                return tmp;
+            }
+
+            constexpr basic_iterator &operator--() noexcept
+            {
+                --idx;
+                return *this;
+            }
+
+            constexpr basic_iterator operator--(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                --idx;
+                return tmp;
+            }
+
+            constexpr basic_iterator &operator+=(difference_type n) noexcept
+            {
+                idx = static_cast<size_type>(static_cast<difference_type>(idx) + n);
+                return *this;
+            }
+
+            constexpr basic_iterator &operator-=(difference_type n) noexcept
+            {
+                return *this += -n;
+            }
+
+            friend constexpr basic_iterator operator+(basic_iterator iter, difference_type n) noexcept { return iter += n; }
+
+            friend constexpr basic_iterator operator+(difference_type n, basic_iterator iter) noexcept { return iter += n; }
+
+            friend constexpr basic_iterator operator-(basic_iterator iter, difference_type n) noexcept { return iter -= n; }
+
+            friend constexpr difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs) noexcept
+            {
+                return static_cast<difference_type>(lhs.idx) - static_cast<difference_type>(rhs.idx);
+            }
+
+            friend constexpr bool operator==(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx == rhs.idx; }
+
+            friend constexpr std::strong_ordering operator<=>(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx <=> rhs.idx; }
+
+        private:
+            friend class static_flat_map;
+            friend class basic_iterator<!Const>;
+
+            using owner_type = std::conditional_t<Const, const static_flat_map, static_flat_map>;
+
+            constexpr basic_iterator(owner_type *map, size_type pos) noexcept : owner(map), idx(pos) {}
+
+            owner_type *owner{nullptr};
+            size_type idx{0};
+        };
+    };
+
+}// namespace ksv
+
+namespace std
+{
+
+    // pair_ref<K, V> and std::pair<K, V> qualified as Qual meet in a pair_ref
+    // to the elements qualified as both, like std::pair does from C++23 on
+    template<typename K, typename V, template<typename> class RefQual, template<typename> class Qual>
+    struct basic_common_reference<ksv::detail::pair_ref<K, V>, pair<remove_const_t<K>, remove_const_t<V>>, RefQual, Qual>
+    {
+        using type = ksv::detail::pair_ref<remove_reference_t<common_reference_t<K &, Qual<remove_const_t<K>>>>,
+                                           remove_reference_t<common_reference_t<V &, Qual<remove_const_t<V>>>>>;
+    };
+
+    template<typename K, typename V, template<typename> class Qual, template<typename> class RefQual>
+    struct basic_common_reference<pair<remove_const_t<K>, remove_const_t<V>>, ksv::detail::pair_ref<K, V>, Qual, RefQual>
+        : basic_common_reference<ksv::detail::pair_ref<K, V>, pair<remove_const_t<K>, remove_const_t<V>>, RefQual, Qual>
+    {
+    };
+
+    template<typename K, typename V>
+    struct tuple_size<ksv::detail::pair_ref<K, V>> : integral_constant<size_t, 2>
+    {
+    };
+
+    template<size_t I, typename K, typename V>
+    struct tuple_element<I, ksv::detail::pair_ref<K, V>> : tuple_element<I, pair<K &, V &>>
+    {
+    };
+
+}// namespace std
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "static_flat_map.h"
+#include "static_vector.h"
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    // Sorted set of up to N unique keys kept contiguous in a static_vector,
+    // searched like the keys of static_flat_map.
+    // Iterators are invalidated by every insertion and erasure.
+    template<typename K, std::size_t N, typename Compare = std::less<K>>
+    class static_flat_set
+    {
+    public:
+        // type aliases
+        using key_type = K;
+        using value_type = K;
+        using key_compare = Compare;
+        using value_compare = Compare;
+        using reference = K &;
+        using const_reference = const K &;
+        using iterator = const K *;
+        using const_iterator = const K *;
+        using riterator = std::reverse_iterator<iterator>;
+        using const_riterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using container_type = static_vector<K, N>;
+
+        // ctors
+        constexpr static_flat_set() = default;
+
+        constexpr explicit static_flat_set(const Compare &compare) : comp(compare) {}
+
+        template<std::input_iterator Iter>
+        constexpr static_flat_set(Iter first, Iter last)
+        {
+            insert(first, last);
+        }
+
+        template<std::input_iterator Iter>
+        constexpr static_flat_set(sorted_unique_t, Iter first, Iter last)
+        {
+            insert(sorted_unique, first, last);
+        }
+
+        constexpr static_flat_set(std::initializer_list<K> list) : static_flat_set(list.begin(), list.end()) {}
+
+        constexpr static_flat_set(sorted_unique_t, std::initializer_list<K> list) : static_flat_set(sorted_unique, list.begin(), list.end()) {}
+
+        // non-mutating functions
+        [[nodiscard]] constexpr bool empty() const { return key_list.empty(); }
+
+        [[nodiscard]] constexpr size_type size() const { return key_list.size(); }
+
+        [[nodiscard]] constexpr size_type capacity() const { return N; }
+
+        constexpr const container_type &keys() const noexcept { return key_list; }
+
+        constexpr key_compare key_comp() const { return comp; }
+
+        constexpr value_compare value_comp() const { return comp; }
+
+        // iterators
+        constexpr const_iterator begin() const { return key_list.begin(); }
+
+        constexpr const_riterator rbegin() const { return const_riterator(end()); }
+
+        constexpr const_iterator end() const { return key_list.end(); }
+
+        constexpr const_riterator rend() const { return const_riterator(begin()); }
+
+        constexpr const_iterator cbegin() const { return begin(); }
+
+        constexpr const_riterator crbegin() const { return rbegin(); }
+
+        constexpr const_iterator cend() const { return end(); }
+
+        constexpr const_riterator crend() const { return rend(); }
+
+        constexpr const K *data() const noexcept { return key_list.data(); }
+
+        // lookup, the Key overloads only take part with a transparent comparator
+        constexpr const_iterator find(const K &key) const { return begin() + find_index(key); }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr const_iterator find(const Key &key) const
+        {
+            return begin() + find_index(key);
+        }
+
+        constexpr bool contains(const K &key) const { return find_index(key) != size(); }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr bool contains(const Key &key) const
+        {
+            return find_index(key) != size();
+        }
+
+        constexpr size_type count(const K &key) const { return contains(key) ? 1 : 0; }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr size_type count(const Key &key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        constexpr const_iterator lower_bound(const K &key) const { return begin() + lower_index(key); }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr const_iterator lower_bound(const Key &key) const
+        {
+            return begin() + lower_index(key);
+        }
+
+        constexpr const_iterator upper_bound(const K &key) const { return begin() + upper_index(key); }
+
+        template<typename Key>
+            requires detail::transparent_compare<Compare>
+        constexpr const_iterator upper_bound(const Key &key) const
+        {
+            return begin() + upper_index(key);
+        }
+
+        // mutating functions
+        // addition
+        template<typename... Args>
+        constexpr std::pair<const_iterator, bool> emplace(Args &&...args)
+        {
+            return insert_internal(K(std::forward<Args>(args)...));
+        }
+
+        constexpr std::pair<const_iterator, bool> insert(const K &key)
+        {
+            return insert_internal(key);
+        }
+
+        constexpr std::pair<const_iterator, bool> insert(K &&key)
+        {
+            return insert_internal(std::move(key));
+        }
+
+        template<std::input_iterator Iter>
+        constexpr void insert(Iter first, Iter last)
+        {
+            for (; first != last; ++first)
+                emplace(*first);
+        }
+
+        // merges sorted input without duplicates, see static_flat_map
+        template<std::input_iterator Iter>
+        constexpr void insert(sorted_unique_t, Iter first, Iter last)
+        {
+            container_type staged(first, last);
+            detail::merge_staged(comp, std::tie(key_list), std::tie(staged));
+        }
+
+        constexpr void insert(std::initializer_list<K> list)
+        {
+            insert(list.begin(), list.end());
+        }
+
+        constexpr void insert(sorted_unique_t, std::initializer_list<K> list)
+        {
+            insert(sorted_unique, list.begin(), list.end());
+        }
+
+        // removal
+        constexpr const_iterator erase(const_iterator pos)
+        {
+            return key_list.erase(pos);
+        }
+
+        constexpr size_type erase(const K &key)
+        {
+            return erase_key(key);
+        }
+
+        // like std::map, iterators always select the positional erase
+        template<typename Key>
+            requires detail::transparent_compare<Compare> && (!std::is_convertible_v<const Key &, iterator>) && (!std::is_convertible_v<const Key &, const_iterator>)
+        constexpr size_type erase(const Key &key)
+        {
+            return erase_key(key);
+        }
+
+        constexpr void clear()
+        {
+            key_list.clear();
+        }
+
+        // swap
+        friend constexpr void swap(static_flat_set &lhs, static_flat_set &rhs)
+        {
+            using std::swap;
+            swap(lhs.key_list, rhs.key_list);
+            swap(lhs.comp, rhs.comp);
+        }
+
+        // comparison operators
+        friend constexpr bool operator==(const static_flat_set &lhs, const static_flat_set &rhs)
+        {
+            return lhs.key_list == rhs.key_list;
+        }
+
+        friend constexpr bool operator!=(const static_flat_set &lhs, const static_flat_set &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        // instance fields
+        container_type key_list;
+        [[no_unique_address]] Compare comp;
+
+        template<typename Key>
+        constexpr size_type lower_index(const Key &key) const
+        {
+            return detail::sorted_bound<false>(key_list.data(), key_list.size(), key, comp);
+        }
+
+        template<typename Key>
+        constexpr size_type upper_index(const Key &key) const
+        {
+            return detail::sorted_bound<true>(key_list.data(), key_list.size(), key, comp);
+        }
+
+        // index of key, or size() when absent
+        template<typename Key>
+        constexpr size_type find_index(const Key &key) const
+        {
+            const size_type idx{lower_index(key)};
+            return idx != size() && !comp(key, key_list[idx]) ? idx : size();
+        }
+
+        template<typename Key>
+        constexpr size_type erase_key(const Key &key)
+        {
+            const size_type idx{find_index(key)};
+            if (idx == size())
+                return 0;
+            key_list.erase(begin() + idx);
+            return 1;
+        }
+
+        template<typename KeyArg>
+        constexpr std::pair<const_iterator, bool> insert_internal(KeyArg &&key)
+        {
+            const size_type idx{lower_index(key)};
+            if (idx != size() && !comp(key, key_list[idx]))
+                return {begin() + idx, false};
+            return {key_list.insert(begin() + idx, std::forward<KeyArg>(key)), true};
+        }
+    };
+
+}// namespace ksv
@@ -0,0 +1,577 @@
+#pragma once
+
+#include "simd_detail.h"
+#include "static_vector.h"
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    namespace detail
+    {
+        // values of width bits that fill a whole number of 64-bit words
+        template<std::size_t Width>
+        inline constexpr std::size_t packed_period{64 / std::gcd(Width, std::size_t{64})};
+
+        // appends values of a given bit width to a stream of 64-bit words
+        struct packed_writer
+        {
+            std::uint64_t *words;
+            std::uint64_t acc{0};
+            std::size_t fill{0};
+
+            constexpr void put(std::uint64_t value, std::size_t width) noexcept
+            {
+                acc |= value << fill;
+                fill += width;
+                if (fill >= 64)
+                {
+                    *words++ = acc;
+                    fill -= 64;
+                    // the bits of value that did not fit into the stored word
+                    acc = fill != 0 ? value >> (width - fill) : 0;
+                }
+            }
+
+            // stores the partial last word, returns one past the last word written
+            constexpr std::uint64_t *finish() noexcept
+            {
+                if (fill != 0)
+                    *words++ = acc;
+                return words;
+            }
+        };
+
+        // ors value K of a period into the words it covers
+        template<std::size_t Bits, std::size_t K>
+        constexpr void pack_one(std::uint64_t value, std::uint64_t *words) noexcept
+        {
+            constexpr std::size_t offset{K * Bits % 64};
+            words[K * Bits / 64] |= value << offset;
+            if constexpr (offset + Bits > 64)
+                words[K * Bits / 64 + 1] |= value >> (64 - offset);
+        }
+
+        // packs one period of values, fully unrolled so every shift is a constant,
+        // and returns the or of the values
+        template<std::size_t Bits, std::size_t... Ks>
+        constexpr std::uint32_t pack_period(const std::uint32_t *values, std::uint64_t *words, std::index_sequence<Ks...>) noexcept
+        {
+            std::fill_n(words, sizeof...(Ks) * Bits / 64, std::uint64_t{0});
+            (pack_one<Bits, Ks>(values[Ks], words), ...);
+            return (values[Ks] | ...);
+        }
+
+        // returns one past the last word written, seen collects the or of all
+        // values so the caller can check them against the width afterwards
+        template<std::size_t Bits>
+        constexpr std::uint64_t *pack_values(const std::uint32_t *first, std::size_t size, std::uint64_t *words, std::uint32_t &seen) noexcept
+        {
+            constexpr std::size_t period{packed_period<Bits>};
+            const std::uint32_t *last{first + size};
+            for (; last - first >= static_cast<std::ptrdiff_t>(period); first += period, words += period * Bits / 64)
+                seen |= pack_period<Bits>(first, words, std::make_index_sequence<period>{});
+            packed_writer writer{words};
+            for (; first != last; ++first)
+            {
+                writer.put(*first, Bits);
+                seen |= *first;
+            }
+            return writer.finish();
+        }
+
+        // reads value K of a period from the words it covers
+        template<std::size_t Bits, std::size_t K>
+        constexpr std::uint32_t unpack_one(const std::uint64_t *words) noexcept
+        {
+            constexpr std::size_t offset{K * Bits % 64};
+            std::uint64_t value{words[K * Bits / 64] >> offset};
+            if constexpr (offset + Bits > 64)
+                value |= words[K * Bits / 64 + 1] << (64 - offset);
+            return static_cast<std::uint32_t>(value & ((std::uint64_t{1} << Bits) - 1));
+        }
+
+        // unpacks one period of values starting at the first of words
+        template<std::size_t Bits, std::size_t... Ks>
+        constexpr void unpack_period(const std::uint64_t *words, std::uint32_t *out, std::index_sequence<Ks...>) noexcept
+        {
+            ((out[Ks] = unpack_one<Bits, Ks>(words)), ...);
+        }
+
+#if defined(KSV_X86_DISPATCH)
+        // an AVX2 step unpacks 8 values, each lane gathers the 4 bytes holding
+        // its value with a byte shuffle and shifts out up to 7 leading bits
+        template<std::size_t Bits>
+        inline constexpr bool avx2_unpackable{Bits <= 25};
+
+        template<std::size_t Bits>
+        struct unpack_lanes
+        {
+            // first byte of values 4 to 7, which fill the upper 128-bit half
+            static constexpr std::size_t high_byte{4 * Bits / 8};
+
+            static constexpr auto shuffle{[] {
+                std::array<std::int8_t, 32> control{};
+                for (std::size_t k{0}; k < 8; ++k)
+                {
+                    const std::size_t start{k < 4 ? 0 : 8 * high_byte};
+                    for (std::size_t j{0}; j < 4; ++j)
+                        control[4 * k + j] = static_cast<std::int8_t>((k * Bits - start) / 8 + j);
+                }
+                return control;
+            }()};
+
+            static constexpr auto shifts{[] {
+                std::array<std::int32_t, 8> counts{};
+                for (std::size_t k{0}; k < 8; ++k)
+                    counts[k] = static_cast<std::int32_t>(k * Bits % 8);
+                return counts;
+            }()};
+        };
+
+        // unpacks groups of 8 values while their loads stay within the readable
+        // bytes of words, returns how many values were unpacked
+        template<std::size_t Bits>
+        KSV_TARGET_AVX2 inline std::size_t unpack_avx2(const std::uint64_t *words, std::size_t readable, std::size_t size, std::uint32_t *out) noexcept
+        {
+            using lanes = unpack_lanes<Bits>;
+            const __m256i shuffle{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes::shuffle.data()))};
+            const __m256i shifts{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes::shifts.data()))};
+            const __m256i mask{_mm256_set1_epi32(static_cast<int>((std::uint32_t{1} << Bits) - 1))};
+            const auto *bytes{reinterpret_cast<const unsigned char *>(words)};
+
+            std::size_t i{0};
+            for (; i + 8 <= size && i * Bits / 8 + lanes::high_byte + 16 <= readable; i += 8)
+            {
+                const unsigned char *group{bytes + i * Bits / 8};
+                const __m128i low{_mm_loadu_si128(reinterpret_cast<const __m128i *>(group))};
+                const __m128i high{_mm_loadu_si128(reinterpret_cast<const __m128i *>(group + lanes::high_byte))};
+                const __m256i raw{_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1)};
+                const __m256i values{_mm256_and_si256(_mm256_srlv_epi32(_mm256_shuffle_epi8(raw, shuffle), shifts), mask)};
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), values);
+            }
+            return i;
+        }
+#endif
+    }// namespace detail
+
+    // Fixed-capacity vector of up to N unsigned integers of Bits bits each,
+    // packed back to back into 64-bit words. A value may straddle two words.
+    // Bits past the last value are kept zero, and one zero word follows the
+    // packed ones so every value can be read with two loads and no branch.
+    template<std::size_t Bits, std::size_t N>
+    class static_packed_vector
+    {
+        static_assert(Bits >= 1 && Bits <= 32, "static_packed_vector holds values of 1 to 32 bits.");
+
+        template<bool Const>
+        class basic_iterator;
+
+    public:
+        class reference;
+
+        // type aliases
+        using value_type = std::uint32_t;
+        using word_type = std::uint64_t;
+        using const_reference = value_type;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using riterator = std::reverse_iterator<iterator>;
+        using const_riterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        static constexpr size_type bits_per_word{64};
+        static constexpr size_type word_count{(N * Bits + bits_per_word - 1) / bits_per_word};
+
+        // largest value that fits into Bits bits
+        static constexpr value_type max_value{static_cast<value_type>((word_type{1} << Bits) - 1)};
+
+        // ctors
+        constexpr static_packed_vector() noexcept = default;
+
+        constexpr static_packed_vector(size_type count, value_type value)
+        {
+            resize(count, value);
+        }
+
+        constexpr static_packed_vector(std::initializer_list<value_type> list)
+        {
+            validate_count(list.size());
+            for (const value_type value : list)
+                push_back(value);
+        }
+
+        constexpr explicit static_packed_vector(const static_vector<value_type, N> &values)
+        {
+            pack(values);
+        }
+
+        // non-mutating functions
+        [[nodiscard]] constexpr bool empty() const noexcept { return curr_size == 0; }
+
+        [[nodiscard]] constexpr size_type size() const noexcept { return curr_size; }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return N; }
+
+        // validated element access
+        constexpr value_type at(size_type pos) const
+        {
+            validate_index(pos);
+            return get(pos);
+        }
+
+        constexpr reference at(size_type pos)
+        {
+            validate_index(pos);
+            return (*this)[pos];
+        }
+
+        // non-validated element access
+        constexpr value_type operator[](size_type pos) const { return get(pos); }
+
+        constexpr reference operator[](size_type pos) { return reference(this, pos); }
+
+        constexpr value_type front() const { return get(0); }
+
+        constexpr reference front() { return (*this)[0]; }
+
+        constexpr value_type back() const { return get(curr_size - 1); }
+
+        constexpr reference back() { return (*this)[curr_size - 1]; }
+
+        // iterators
+        constexpr iterator begin() noexcept { return iterator(this, 0); }
+
+        constexpr riterator rbegin() noexcept { return riterator(end()); }
+
+        constexpr const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+        constexpr const_riterator rbegin() const noexcept { return const_riterator(end()); }
+
+        constexpr iterator end() noexcept { return iterator(this, curr_size); }
+
+        constexpr riterator rend() noexcept { return riterator(begin()); }
+
+        constexpr const_iterator end() const noexcept { return const_iterator(this, curr_size); }
+
+        constexpr const_riterator rend() const noexcept { return const_riterator(begin()); }
+
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+        constexpr const_riterator crbegin() const noexcept { return rbegin(); }
+
+        constexpr const_iterator cend() const noexcept { return end(); }
+
+        constexpr const_riterator crend() const noexcept { return rend(); }
+
+        // the packed words, value i occupies bits [i * Bits, (i + 1) * Bits) of the stream
+        constexpr std::span<const word_type, word_count> words() const noexcept { return std::span<const word_type, word_count>(words_data, word_count); }
+
+        // replaces the contents of out with all values, widened to 32 bits
+        constexpr void unpack(static_vector<value_type, N> &out) const
+        {
+            out.resize_and_overwrite(curr_size, [this](value_type *dest, size_type count) {
+                size_type i{0};
+#if defined(KSV_X86_DISPATCH)
+                if constexpr (detail::avx2_unpackable<Bits>)
+                {
+                    if (!std::is_constant_evaluated())
+                    {
+#if defined(__AVX2__)
+                        i = detail::unpack_avx2<Bits>(words_data, sizeof(words_data), count, dest);
+#else
+                        if (__builtin_cpu_supports("avx2"))
+                            i = detail::unpack_avx2<Bits>(words_data, sizeof(words_data), count, dest);
+#endif
+                    }
+                }
+#endif
+                // whole periods start on a word boundary
+                constexpr size_type period{detail::packed_period<Bits>};
+                if constexpr (period <= N)
+                    if (i % period == 0)
+                        for (; i + period <= count; i += period)
+                            detail::unpack_period<Bits>(words_data + i * Bits / bits_per_word, dest + i, std::make_index_sequence<period>{});
+                for (; i < count; ++i)
+                    dest[i] = get(i);
+                return count;
+            });
+        }
+
+        // mutating functions
+        // validated value modification
+        constexpr static_packed_vector &set(size_type pos, value_type value)
+        {
+            validate_index(pos);
+            validate_value(value);
+            put(pos, value);
+            return *this;
+        }
+
+        // addition
+        constexpr void push_back(value_type value)
+        {
+            if (curr_size >= N)
+                KSV_THROW(std::length_error("Reached max capacity."), "Reached max capacity.");
+            validate_value(value);
+            put(curr_size, value);
+            ++curr_size;
+        }
+
+        // replaces the contents with values, every one of which has to fit into
+        // Bits bits, otherwise the vector is left empty
+        constexpr void pack(const static_vector<value_type, N> &values)
+        {
+            value_type seen{0};
+            word_type *last{detail::pack_values<Bits>(values.data(), values.size(), words_data, seen)};
+            std::fill(last, std::end(words_data), word_type{0});
+            curr_size = static_cast<detail::size_for<N>>(values.size());
+            if (seen > max_value)
+            {
+                clear();
+                validate_value(seen);
+            }
+        }
+
+        // removal
+        constexpr void pop_back()
+        {
+            --curr_size;
+            put(curr_size, 0);
+        }
+
+        constexpr void clear() noexcept
+        {
+            std::fill(std::begin(words_data), std::end(words_data), word_type{0});
+            curr_size = 0;
+        }
+
+        constexpr void resize(size_type count, value_type value = 0)
+        {
+            validate_count(count);
+            validate_value(value);
+            const size_type old_size{curr_size};
+            curr_size = static_cast<detail::size_for<N>>(count);
+            if (count < old_size)
+                clear_tail();
+            else if (value != 0)
+                for (size_type i{old_size}; i < count; ++i)
+                    put(i, value);
+        }
+
+        // swap
+        friend constexpr void swap(static_packed_vector &lhs, static_packed_vector &rhs) noexcept
+        {
+            std::swap(lhs.words_data, rhs.words_data);
+            std::swap(lhs.curr_size, rhs.curr_size);
+        }
+
+        // comparison operators
+        friend constexpr bool operator==(const static_packed_vector &lhs, const static_packed_vector &rhs) noexcept
+        {
+            return lhs.curr_size == rhs.curr_size && std::equal(std::begin(lhs.words_data), std::end(lhs.words_data), std::begin(rhs.words_data));
+        }
+
+        // proxy for a single value, assignable from value_type and convertible to it,
+        // assigned values are truncated to Bits bits
+        class reference
+        {
+        public:
+            constexpr reference &operator=(value_type value) noexcept
+            {
+                std::as_const(*this) = value;
+                return *this;
+            }
+
+            constexpr reference &operator=(const reference &other) noexcept
+            {
+                return *this = static_cast<value_type>(other);
+            }
+
+            // assigning through a const proxy still writes the referenced value
+            constexpr const reference &operator=(value_type value) const noexcept
+            {
+                owner->put(pos, value & max_value);
+                return *this;
+            }
+
+            constexpr operator value_type() const noexcept { return owner->get(pos); }
+
+            friend constexpr void swap(reference lhs, reference rhs) noexcept
+            {
+                const value_type tmp{lhs};
+                lhs = static_cast<value_type>(rhs);
+                rhs = tmp;
+            }
+
+        private:
+            friend class static_packed_vector;
+
+            constexpr reference(static_packed_vector *vec, size_type index) noexcept : owner(vec), pos(index) {}
+
+            static_packed_vector *owner;
+            size_type pos;
+        };
+
+    private:
+        static constexpr word_type value_mask{max_value};
+
+        // instance fields
+        word_type words_data[word_count + 1]{};
+        detail::size_for<N> curr_size{0};
+
+        // the high part of a value comes from the next word, shifting in two
+        // steps keeps a value that starts at bit 0 of its word from shifting by 64
+        constexpr value_type get(size_type pos) const noexcept
+        {
+            const size_type offset{pos * Bits};
+            const size_type idx{offset / bits_per_word};
+            const size_type shift{offset % bits_per_word};
+            const word_type low{words_data[idx] >> shift};
+            const word_type high{(words_data[idx + 1] << 1) << (bits_per_word - 1 - shift)};
+            return static_cast<value_type>((low | high) & value_mask);
+        }
+
+        // value has to fit into Bits bits
+        constexpr void put(size_type pos, value_type value) noexcept
+        {
+            const size_type offset{pos * Bits};
+            const size_type idx{offset / bits_per_word};
+            const size_type shift{offset % bits_per_word};
+            const word_type wide{value};
+            words_data[idx] = (words_data[idx] & ~(value_mask << shift)) | (wide << shift);
+            const size_type spill{bits_per_word - 1 - shift};
+            words_data[idx + 1] = (words_data[idx + 1] & ~((value_mask >> 1) >> spill)) | ((wide >> 1) >> spill);
+        }
+
+        // zeroes every bit past size() to restore the invariant
+        constexpr void clear_tail() noexcept
+        {
+            const size_type offset{curr_size * Bits};
+            const size_type idx{offset / bits_per_word};
+            words_data[idx] &= (word_type{1} << (offset % bits_per_word)) - 1;
+            std::fill(std::begin(words_data) + idx + 1, std::end(words_data), word_type{0});
+        }
+
+        // methods for validation
+        constexpr void validate_index(size_type index) const
+        {
+            if (index >= curr_size)
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+        }
+
+        constexpr void validate_count(size_type count) const
+        {
+            if (count > N)
+                KSV_THROW(std::bad_alloc(), "Exceeded capacity.");
+        }
+
+        constexpr void validate_value(value_type value) const
+        {
+            if (value > max_value)
+                KSV_THROW(std::out_of_range("Value exceeds bit width."), "Value exceeds bit width.");
+        }
+
+        // random access iterator holding the index of a value
+        template<bool Const>
+        class basic_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+            using value_type = std::uint32_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::conditional_t<Const, value_type, static_packed_vector::reference>;
+
+            constexpr basic_iterator() noexcept = default;
+
+            // non-const to const conversion
+            template<bool OtherConst>
+                requires(Const && !OtherConst)
+            constexpr basic_iterator(const basic_iterator<OtherConst> &other) noexcept : owner(other.owner), idx(other.idx)
+            {}
+
+            constexpr reference operator*() const { return (*owner)[idx]; }
+
+            constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+            constexpr basic_iterator &operator++() noexcept
+            {
+                ++idx;
+                return *this;
+            }
+
+            constexpr basic_iterator operator++(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                ++idx;
+                return tmp;
+            }
+
+            constexpr basic_iterator &operator--() noexcept
+            {
+                --idx;
+                return *this;
+            }
+
+            constexpr basic_iterator operator--(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                --idx;
+                return tmp;
+            }
+
+            constexpr basic_iterator &operator+=(difference_type n) noexcept
+            {
+                idx = static_cast<size_type>(static_cast<difference_type>(idx) + n);
+                return *this;
+            }
+
+            constexpr basic_iterator &operator-=(difference_type n) noexcept
+            {
+                return *this += -n;
+            }
+
+            friend constexpr basic_iterator operator+(basic_iterator iter, difference_type n) noexcept { return iter += n; }
+
+            friend constexpr basic_iterator operator+(difference_type n, basic_iterator iter) noexcept { return iter += n; }
+
+            friend constexpr basic_iterator operator-(basic_iterator iter, difference_type n) noexcept { return iter -= n; }
+
+            friend constexpr difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs) noexcept
+            {
+                return static_cast<difference_type>(lhs.idx) - static_cast<difference_type>(rhs.idx);
+            }
+
+            friend constexpr bool operator==(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx == rhs.idx; }
+
+            friend constexpr std::strong_ordering operator<=>(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx <=> rhs.idx; }
+
+        private:
+            friend class static_packed_vector;
+            friend class basic_iterator<!Const>;
+
+            using owner_type = std::conditional_t<Const, const static_packed_vector, static_packed_vector>;
+
+            constexpr basic_iterator(owner_type *vec, size_type pos) noexcept : owner(vec), idx(pos) {}
+
+            owner_type *owner{nullptr};
+            size_type idx{0};
+        };
+    };
+
+}// namespace ksv
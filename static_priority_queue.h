@@ -0,0 +1,267 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+namespace ksv
+{
+
+    // Fixed-capacity priority queue of up to N elements kept as an implicit
+    // heap with Arity children per node in a static_vector. Like
+    // std::priority_queue, top() is the element that compares greatest.
+    // Wider nodes make the heap shallower: a sift down compares all Arity
+    // children, which lie next to each other, at every one of fewer levels.
+    template<typename T, std::size_t N, typename Compare = std::less<T>, std::size_t Arity = 4>
+    class static_priority_queue
+    {
+        static_assert(Arity >= 2, "static_priority_queue needs at least two children per node.");
+
+    public:
+        // type aliases
+        using value_type = T;
+        using value_compare = Compare;
+        using reference = T &;
+        using const_reference = const T &;
+        using size_type = std::size_t;
+        using container_type = static_vector<T, N>;
+
+        static constexpr size_type arity{Arity};
+
+        // ctors
+        constexpr static_priority_queue() = default;
+
+        constexpr explicit static_priority_queue(const Compare &compare) : comp(compare) {}
+
+        template<std::input_iterator Iter>
+        constexpr static_priority_queue(Iter first, Iter last, const Compare &compare = Compare()) : comp(compare)
+        {
+            heapify(first, last);
+        }
+
+        template<std::ranges::input_range R>
+        constexpr static_priority_queue(from_range_t, R &&range, const Compare &compare = Compare()) : comp(compare)
+        {
+            heapify_range(std::forward<R>(range));
+        }
+
+        constexpr static_priority_queue(std::initializer_list<T> list, const Compare &compare = Compare()) : static_priority_queue(list.begin(), list.end(), compare) {}
+
+        // non-mutating functions
+        [[nodiscard]] constexpr bool empty() const noexcept { return heap.empty(); }
+
+        [[nodiscard]] constexpr size_type size() const noexcept { return heap.size(); }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return N; }
+
+        // the elements in heap order, an element's index here is what decrease_key takes
+        constexpr const container_type &values() const noexcept { return heap; }
+
+        constexpr value_compare value_comp() const { return comp; }
+
+        // non-validated element access
+        constexpr const_reference top() const { return heap.front(); }
+
+        // mutating functions
+        // addition
+        constexpr void push(const T &value)
+        {
+            heap.push_back(value);
+            sift_up_back();
+        }
+
+        constexpr void push(T &&value)
+        {
+            heap.push_back(std::move(value));
+            sift_up_back();
+        }
+
+        template<typename... Args>
+        constexpr void emplace(Args &&...args)
+        {
+            heap.emplace_back(std::forward<Args>(args)...);
+            sift_up_back();
+        }
+
+        // removal
+        constexpr void pop()
+        {
+            T last{std::move(heap.back())};
+            heap.pop_back();
+            if (!heap.empty())
+                sift_down(0, std::move(last));
+        }
+
+        constexpr void clear() noexcept
+        {
+            heap.clear();
+        }
+
+        // replacement
+        // same as pop() followed by push(value), with a single sift down;
+        // an empty queue only gets value pushed
+        constexpr void replace_top(const T &value)
+        {
+            if (heap.empty())
+                push(value);
+            else
+                sift_down(0, T(value));
+        }
+
+        constexpr void replace_top(T &&value)
+        {
+            if (heap.empty())
+                push(std::move(value));
+            else
+                sift_down(0, std::move(value));
+        }
+
+        // gives the element at idx of values() a new value that compares no
+        // less than the old one, moving it towards the top
+        constexpr void decrease_key(size_type idx, const T &value)
+        {
+            validate_index(idx);
+            sift_up(idx, T(value));
+        }
+
+        constexpr void decrease_key(size_type idx, T &&value)
+        {
+            validate_index(idx);
+            sift_up(idx, std::move(value));
+        }
+
+        // replaces the contents with the elements of a range and builds the
+        // heap bottom up in linear time
+        template<std::input_iterator Iter>
+        constexpr void heapify(Iter first, Iter last)
+        {
+            heap.assign(first, last);
+            make_heap();
+        }
+
+        template<std::ranges::input_range R>
+        constexpr void heapify_range(R &&range)
+        {
+            heap.assign_range(std::forward<R>(range));
+            make_heap();
+        }
+
+        // swap
+        friend constexpr void swap(static_priority_queue &lhs, static_priority_queue &rhs)
+        {
+            using std::swap;
+            swap(lhs.heap, rhs.heap);
+            swap(lhs.comp, rhs.comp);
+        }
+
+    private:
+        // instance fields
+        container_type heap;
+        [[no_unique_address]] Compare comp;
+
+        static constexpr size_type parent_of(size_type idx) noexcept { return (idx - 1) / Arity; }
+
+        static constexpr size_type first_child_of(size_type idx) noexcept { return Arity * idx + 1; }
+
+        // methods for validation
+        constexpr void validate_index(size_type index) const
+        {
+            if (index >= heap.size())
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+        }
+
+        // internally used heap functions, both move the elements on the path
+        // of value into the hole at idx and place value once at its final position
+        constexpr void sift_up(size_type idx, T value)
+        {
+            T *data{heap.data()};
+            while (idx > 0)
+            {
+                const size_type parent{parent_of(idx)};
+                if (!comp(data[parent], value))
+                    break;
+                data[idx] = std::move(data[parent]);
+                idx = parent;
+            }
+            data[idx] = std::move(value);
+        }
+
+        constexpr void sift_up_back()
+        {
+            const size_type idx{heap.size() - 1};
+            sift_up(idx, std::move(heap[idx]));
+        }
+
+        // index of the greatest of Count children starting at first, picked
+        // as a tournament of depth log2(Count) without branches, which random
+        // keys would mispredict half of the time
+        template<size_type Count>
+        constexpr size_type best_of(const T *data, size_type first) const
+        {
+            if constexpr (Count == 1)
+                return first;
+            else
+            {
+                const size_type lhs{best_of<Count / 2>(data, first)};
+                const size_type rhs{best_of<Count - Count / 2>(data, first + Count / 2)};
+                // arithmetic select, GCC turns the ternary into a branch
+                return lhs + static_cast<size_type>(comp(data[lhs], data[rhs])) * (rhs - lhs);
+            }
+        }
+
+        // value usually comes from the bottom of the heap and belongs near it
+        // again, so the hole first moves down to a leaf along the greatest
+        // children without comparing against value, then value sifts up from there
+        constexpr void sift_down(size_type idx, T value)
+        {
+            T *data{heap.data()};
+            const size_type size{heap.size()};
+            const size_type start{idx};
+
+            // nodes with all Arity children
+            while (first_child_of(idx) + Arity <= size)
+            {
+                const size_type best{best_of<Arity>(data, first_child_of(idx))};
+                data[idx] = std::move(data[best]);
+                idx = best;
+            }
+
+            // at most one node has fewer children
+            if (const size_type first{first_child_of(idx)}; first < size)
+            {
+                size_type best{first};
+                for (size_type child{first + 1}; child < size; ++child)
+                    if (comp(data[best], data[child]))
+                        best = child;
+                data[idx] = std::move(data[best]);
+                idx = best;
+            }
+
+            while (idx > start)
+            {
+                const size_type parent{parent_of(idx)};
+                if (!comp(data[parent], value))
+                    break;
+                data[idx] = std::move(data[parent]);
+                idx = parent;
+            }
+            data[idx] = std::move(value);
+        }
+
+        constexpr void make_heap()
+        {
+            if (heap.size() < 2)
+                return;
+            for (size_type idx{parent_of(heap.size() - 1) + 1}; idx-- > 0;)
+                sift_down(idx, std::move(heap[idx]));
+        }
+    };
+
+}// namespace ksv
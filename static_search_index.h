@@ -0,0 +1,161 @@
+#pragma once
+
+#include "simd_detail.h"
+#include "static_vector.h"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace ksv
+{
+
+    // Read-only index over a sorted static_vector of up to N elements, laid
+    // out as a static B-tree (S-tree): every node holds node_size keys on its
+    // own cache line and has node_size + 1 children, stored in breadth-first
+    // order so that the children of node k are the nodes k * (node_size + 1) + 1
+    // onwards. A lookup reads one node per level, log(size) / log(node_size + 1)
+    // dependent loads instead of the log2(size) of a binary search, and picks
+    // the child by counting the keys below the searched one, with SSE2 for
+    // small arithmetic keys and without branches in every case.
+    template<typename T, std::size_t N, typename Compare = std::less<T>>
+        requires std::semiregular<T>
+    class static_search_index
+    {
+    public:
+        // type aliases
+        using value_type = T;
+        using value_compare = Compare;
+        using size_type = std::size_t;
+
+        // keys per node
+        static constexpr size_type node_size{std::max<size_type>(detail::cache_line_size / sizeof(T), 2)};
+
+        // ctors
+        constexpr static_search_index() = default;
+
+        constexpr explicit static_search_index(const static_vector<T, N> &sorted, const Compare &compare = Compare()) : comp(compare)
+        {
+            build(sorted);
+        }
+
+        // non-mutating functions
+        [[nodiscard]] constexpr bool empty() const noexcept { return curr_size == 0; }
+
+        [[nodiscard]] constexpr size_type size() const noexcept { return curr_size; }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return N; }
+
+        constexpr value_compare value_comp() const { return comp; }
+
+        // searching
+        // index in the sorted vector of the first element not ordered before key, or size()
+        constexpr size_type lower_bound(const T &key) const
+        {
+            const size_type slot{lower_bound_slot(key)};
+            return slot == npos ? curr_size : ranks[slot];
+        }
+
+        constexpr bool contains(const T &key) const
+        {
+            const size_type slot{lower_bound_slot(key)};
+            return slot != npos && !comp(key, nodes[slot / node_size].keys[slot % node_size]);
+        }
+
+        // mutating functions
+        // replaces the indexed elements, sorted has to be ordered by Compare
+        constexpr void build(const static_vector<T, N> &sorted)
+        {
+            curr_size = static_cast<detail::size_for<N>>(sorted.size());
+            node_count = (sorted.size() + node_size - 1) / node_size;
+            size_type next{0};
+            fill(0, sorted, next);
+        }
+
+    private:
+        struct alignas(detail::cache_line_size) node
+        {
+            T keys[node_size]{};
+        };
+
+        static constexpr size_type max_nodes{(N + node_size - 1) / node_size};
+
+        static constexpr size_type npos{static_cast<size_type>(-1)};
+
+        // instance fields
+        node nodes[max_nodes == 0 ? 1 : max_nodes]{};
+        // position in the sorted vector of the key in each slot
+        detail::size_for<N> ranks[(max_nodes == 0 ? 1 : max_nodes) * node_size]{};
+        size_type node_count{0};
+        detail::size_for<N> curr_size{0};
+        [[no_unique_address]] Compare comp;
+
+        static constexpr size_type child_of(size_type k, size_type i) noexcept { return k * (node_size + 1) + i + 1; }
+
+        // number of keys of node k ordered before key
+        constexpr size_type count_below(size_type k, const T &key) const
+        {
+            const T *keys{nodes[k].keys};
+#if defined(__SSE2__)
+            if constexpr (detail::simd_searchable<T, T, Compare>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    // a node is a whole number of aligned 16-byte blocks, and
+                    // as its keys are sorted the lanes below key form a prefix
+                    // of the combined mask, whose length needs no popcount
+                    constexpr size_type lanes{16 / sizeof(T)};
+                    constexpr size_type bits_per_lane{std::is_same_v<T, float> || sizeof(T) == 4 ? 1 : sizeof(T)};
+                    const __m128i needle{detail::broadcast(key)};
+                    std::uint64_t below{0};
+                    for (size_type i{0}; i < node_size; i += lanes)
+                    {
+                        const __m128i block{_mm_load_si128(reinterpret_cast<const __m128i *>(keys + i))};
+                        below |= std::uint64_t{detail::greater_mask<T>(needle, block)} << (i * bits_per_lane);
+                    }
+                    return static_cast<size_type>(std::countr_zero(~below)) / bits_per_lane;
+                }
+            }
+#endif
+            size_type below{0};
+            for (size_type i{0}; i < node_size; ++i)
+                below += comp(keys[i], key);
+            return below;
+        }
+
+        // slot of the lower bound of key, the last slot on the search path
+        // whose key is not ordered before key, or npos
+        constexpr size_type lower_bound_slot(const T &key) const
+        {
+            size_type slot{npos};
+            for (size_type k{0}; k < node_count;)
+            {
+                const size_type i{count_below(k, key)};
+                slot = i < node_size ? k * node_size + i : slot;
+                k = child_of(k, i);
+            }
+            return slot;
+        }
+
+        // fills the nodes in key order with an in-order traversal, the slots
+        // past the last element repeat it so every node stays sorted
+        constexpr void fill(size_type k, const static_vector<T, N> &sorted, size_type &next)
+        {
+            if (k >= node_count)
+                return;
+            for (size_type i{0}; i < node_size; ++i)
+            {
+                fill(child_of(k, i), sorted, next);
+                nodes[k].keys[i] = sorted[std::min(next, sorted.size() - 1)];
+                ranks[k * node_size + i] = static_cast<detail::size_for<N>>(std::min(next, sorted.size()));
+                ++next;
+            }
+            fill(child_of(k, node_size), sorted, next);
+        }
+    };
+
+}// namespace ksv
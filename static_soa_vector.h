@@ -0,0 +1,493 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    namespace detail
+    {
+        // a row of references to fields, a std::tuple of them that std::ranges
+        // can relate to the tuple of values through std::basic_common_reference
+        template<typename... Ts>
+        struct row_ref : std::tuple<Ts &...>
+        {
+            using std::tuple<Ts &...>::operator=;
+
+            constexpr row_ref(Ts &...refs) noexcept : std::tuple<Ts &...>(refs...) {}
+
+            template<typename... Others>
+                requires(sizeof...(Others) == sizeof...(Ts)) && (std::is_convertible_v<Others &, Ts &> && ...)
+            constexpr row_ref(const row_ref<Others...> &other) noexcept : std::tuple<Ts &...>(static_cast<const std::tuple<Others &...> &>(other))
+            {}
+
+            template<typename... Others>
+                requires(sizeof...(Others) == sizeof...(Ts)) && (std::is_convertible_v<Others &, Ts &> && ...)
+            constexpr row_ref(std::tuple<Others...> &values) noexcept : std::tuple<Ts &...>(values)
+            {}
+
+            template<typename... Others>
+                requires(sizeof...(Others) == sizeof...(Ts)) && (std::is_convertible_v<const Others &, Ts &> && ...)
+            constexpr row_ref(const std::tuple<Others...> &values) noexcept : std::tuple<Ts &...>(values)
+            {}
+        };
+    }// namespace detail
+
+    // Fixed-capacity vector of up to N rows stored as one array per field
+    // (struct of arrays), so that a loop over one field only loads that field.
+    // Each array starts on its own cache line and all share one size.
+    // Rows are accessed through tuples of references to their fields.
+    template<std::size_t N, typename... Fields>
+    class static_soa_vector
+    {
+        static_assert(sizeof...(Fields) > 0, "static_soa_vector needs at least one field.");
+
+        template<bool Const>
+        class basic_iterator;
+
+    public:
+        // type aliases
+        using value_type = std::tuple<Fields...>;
+        using reference = detail::row_ref<Fields...>;
+        using const_reference = detail::row_ref<const Fields...>;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using riterator = std::reverse_iterator<iterator>;
+        using const_riterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        template<std::size_t I>
+        using field_type = std::tuple_element_t<I, value_type>;
+
+        // ctors
+        constexpr static_soa_vector() noexcept = default;
+
+        constexpr static_soa_vector(const static_soa_vector &other)
+        {
+            copy_rows(other);
+        }
+
+        constexpr static_soa_vector(static_soa_vector &&other) noexcept((std::is_nothrow_move_constructible_v<Fields> && ...))
+        {
+            move_rows(other);
+        }
+
+        // assignments
+        constexpr static_soa_vector &operator=(const static_soa_vector &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                copy_rows(other);
+            }
+            return *this;
+        }
+
+        constexpr static_soa_vector &operator=(static_soa_vector &&other) noexcept((std::is_nothrow_move_constructible_v<Fields> && ...))
+        {
+            if (this != &other)
+            {
+                clear();
+                move_rows(other);
+            }
+            return *this;
+        }
+
+        // dtor
+        constexpr ~static_soa_vector()
+        {
+            clear();
+        }
+
+        // non-mutating functions
+        [[nodiscard]] constexpr bool empty() const noexcept { return curr_size == 0; }
+
+        [[nodiscard]] constexpr size_type size() const noexcept { return curr_size; }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return N; }
+
+        // field access, the span covers the size() values of field I
+        template<std::size_t I>
+        constexpr std::span<field_type<I>> column() noexcept
+        {
+            return std::span<field_type<I>>(column_ptr<I>(), curr_size);
+        }
+
+        template<std::size_t I>
+        constexpr std::span<const field_type<I>> column() const noexcept
+        {
+            return std::span<const field_type<I>>(column_ptr<I>(), curr_size);
+        }
+
+        // validated row access
+        constexpr const_reference at(size_type pos) const
+        {
+            validate_index(pos);
+            return (*this)[pos];
+        }
+
+        constexpr reference at(size_type pos)
+        {
+            validate_index(pos);
+            return (*this)[pos];
+        }
+
+        // non-validated row access
+        constexpr const_reference operator[](size_type pos) const { return row<const_reference>(*this, pos); }
+
+        constexpr reference operator[](size_type pos) { return row<reference>(*this, pos); }
+
+        constexpr const_reference front() const { return (*this)[0]; }
+
+        constexpr reference front() { return (*this)[0]; }
+
+        constexpr const_reference back() const { return (*this)[curr_size - 1]; }
+
+        constexpr reference back() { return (*this)[curr_size - 1]; }
+
+        // iterators
+        constexpr iterator begin() noexcept { return iterator(this, 0); }
+
+        constexpr riterator rbegin() noexcept { return riterator(end()); }
+
+        constexpr const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+        constexpr const_riterator rbegin() const noexcept { return const_riterator(end()); }
+
+        constexpr iterator end() noexcept { return iterator(this, curr_size); }
+
+        constexpr riterator rend() noexcept { return riterator(begin()); }
+
+        constexpr const_iterator end() const noexcept { return const_iterator(this, curr_size); }
+
+        constexpr const_riterator rend() const noexcept { return const_riterator(begin()); }
+
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+        constexpr const_riterator crbegin() const noexcept { return rbegin(); }
+
+        constexpr const_iterator cend() const noexcept { return end(); }
+
+        constexpr const_riterator crend() const noexcept { return rend(); }
+
+        // mutating functions
+        // addition
+        constexpr void push_back(const value_type &values)
+        {
+            std::apply([this](const Fields &...row) { emplace_back(row...); }, values);
+        }
+
+        constexpr void push_back(value_type &&values)
+        {
+            std::apply([this](Fields &...row) { emplace_back(std::move(row)...); }, values);
+        }
+
+        // constructs each field of the new row from the matching argument
+        template<typename... Args>
+            requires(sizeof...(Args) == sizeof...(Fields))
+        constexpr void emplace_back(Args &&...args)
+        {
+            validate_curr_size();
+            construct_row(curr_size, std::forward<Args>(args)...);
+            ++curr_size;
+        }
+
+        // removal
+        constexpr void pop_back()
+        {
+            --curr_size;
+            destroy_row(curr_size);
+        }
+
+        constexpr void clear() noexcept
+        {
+            while (curr_size > 0)
+                pop_back();
+        }
+
+        // swap
+        friend constexpr void swap(static_soa_vector &lhs, static_soa_vector &rhs)
+        {
+            static_soa_vector tmp{std::move(lhs)};
+            lhs = std::move(rhs);
+            rhs = std::move(tmp);
+        }
+
+        // comparison operators
+        friend constexpr bool operator==(const static_soa_vector &lhs, const static_soa_vector &rhs)
+        {
+            if (lhs.size() != rhs.size())
+                return false;
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return (std::ranges::equal(lhs.template column<Is>(), rhs.template column<Is>()) && ...);
+            }(fields);
+        }
+
+        friend constexpr bool operator!=(const static_soa_vector &lhs, const static_soa_vector &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        static constexpr auto fields{std::index_sequence_for<Fields...>{}};
+
+        // row types that may be copied column by column as raw bytes
+        static constexpr bool trivially_copyable = ((std::is_trivially_copyable_v<Fields> && std::is_trivially_destructible_v<Fields>) && ...);
+
+        // one field array, aligned so that vector loops start on a cache line
+        template<typename T>
+        struct alignas(detail::cache_line_size) column_storage : detail::storage_for<T, N>
+        {
+        };
+
+        // instance fields
+        std::tuple<column_storage<Fields>...> columns;
+        detail::size_for<N> curr_size{0};
+
+        template<std::size_t I>
+        constexpr field_type<I> *column_ptr() noexcept { return std::get<I>(columns).ptr(); }
+
+        template<std::size_t I>
+        constexpr const field_type<I> *column_ptr() const noexcept { return std::get<I>(columns).ptr(); }
+
+        template<typename Row, typename Self>
+        static constexpr Row row(Self &self, size_type pos) noexcept
+        {
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return Row(self.template column_ptr<Is>()[pos]...);
+            }(fields);
+        }
+
+        // methods for validation
+        constexpr void validate_index(size_type index) const
+        {
+            if (index >= curr_size)
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+        }
+
+        constexpr void validate_curr_size() const
+        {
+            if (curr_size >= N)
+                KSV_THROW(std::length_error("Reached max capacity."), "Reached max capacity.");
+        }
+
+        // constructs the fields of row idx in order, destroying the ones
+        // already built when a later one throws
+        template<typename... Args>
+        constexpr void construct_row(size_type idx, Args &&...args)
+        {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                size_type built{0};
+                KSV_TRY
+                {
+                    ((std::construct_at(column_ptr<Is>() + idx, std::forward<Args>(args)), ++built), ...);
+                }
+                KSV_CATCH_ALL
+                {
+                    ((Is < built ? std::destroy_at(column_ptr<Is>() + idx) : void()), ...);
+                    KSV_RETHROW;
+                }
+            }(fields);
+        }
+
+        constexpr void destroy_row(size_type idx) noexcept
+        {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (std::destroy_at(column_ptr<Is>() + idx), ...);
+            }(fields);
+        }
+
+        constexpr void copy_rows(const static_soa_vector &other)
+        {
+            if constexpr (trivially_copyable)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                        (std::memcpy(static_cast<void *>(column_ptr<Is>()), other.template column_ptr<Is>(), other.size() * sizeof(Fields)), ...);
+                    }(fields);
+                    curr_size = other.curr_size;
+                    return;
+                }
+            }
+
+            KSV_TRY
+            {
+                for (const auto &values : other)
+                    std::apply([this](const Fields &...row) { emplace_back(row...); }, values);
+            }
+            KSV_CATCH_ALL
+            {
+                clear();
+                KSV_RETHROW;
+            }
+        }
+
+        // moves all rows out of other into this empty vector, leaving other empty
+        constexpr void move_rows(static_soa_vector &other)
+        {
+            if constexpr (trivially_copyable)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    copy_rows(other);
+                    other.curr_size = 0;
+                    return;
+                }
+            }
+
+            KSV_TRY
+            {
+                for (auto values : other)
+                    std::apply([this](Fields &...row) { emplace_back(std::move(row)...); }, values);
+            }
+            KSV_CATCH_ALL
+            {
+                clear();
+                KSV_RETHROW;
+            }
+            other.clear();
+        }
+
+        // random access iterator holding the index of a row,
+        // dereferencing yields a tuple of references to its fields
+        template<bool Const>
+        class basic_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+            using value_type = std::tuple<Fields...>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, static_soa_vector::const_reference, static_soa_vector::reference>;
+
+            // operator-> has to return something that owns the tuple of references
+            struct pointer
+            {
+                reference ref;
+
+                constexpr const reference *operator->() const noexcept { return std::addressof(ref); }
+            };
+
+            constexpr basic_iterator() noexcept = default;
+
+            // non-const to const conversion
+            template<bool OtherConst>
+                requires(Const && !OtherConst)
+            constexpr basic_iterator(const basic_iterator<OtherConst> &other) noexcept : owner(other.owner), idx(other.idx)
+            {}
+
+            constexpr reference operator*() const { return (*owner)[idx]; }
+
+            constexpr pointer operator->() const { return pointer{**this}; }
+
+            constexpr reference operator[](difference_type n) const { return *(*this + n); }
+
+            constexpr basic_iterator &operator++() noexcept
+            {
+                ++idx;
+                return *this;
+            }
+
+            constexpr basic_iterator operator++(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                ++idx;
+                return tmp;
+            }
+
+            constexpr basic_iterator &operator--() noexcept
+            {
+                --idx;
+                return *this;
+            }
+
+            constexpr basic_iterator operator--(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                --idx;
+                return tmp;
+            }
+
+            constexpr basic_iterator &operator+=(difference_type n) noexcept
+            {
+                idx = static_cast<size_type>(static_cast<difference_type>(idx) + n);
+                return *this;
+            }
+
+            constexpr basic_iterator &operator-=(difference_type n) noexcept
+            {
+                return *this += -n;
+            }
+
+            friend constexpr basic_iterator operator+(basic_iterator iter, difference_type n) noexcept { return iter += n; }
+
+            friend constexpr basic_iterator operator+(difference_type n, basic_iterator iter) noexcept { return iter += n; }
+
+            friend constexpr basic_iterator operator-(basic_iterator iter, difference_type n) noexcept { return iter -= n; }
+
+            friend constexpr difference_type operator-(const basic_iterator &lhs, const basic_iterator &rhs) noexcept
+            {
+                return static_cast<difference_type>(lhs.idx) - static_cast<difference_type>(rhs.idx);
+            }
+
+            friend constexpr bool operator==(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx == rhs.idx; }
+
+            friend constexpr std::strong_ordering operator<=>(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx <=> rhs.idx; }
+
+        private:
+            friend class static_soa_vector;
+            friend class basic_iterator<!Const>;
+
+            using owner_type = std::conditional_t<Const, const static_soa_vector, static_soa_vector>;
+
+            constexpr basic_iterator(owner_type *vec, size_type pos) noexcept : owner(vec), idx(pos) {}
+
+            owner_type *owner{nullptr};
+            size_type idx{0};
+        };
+    };
+
+}// namespace ksv
+
+namespace std
+{
+
+    // row_ref<Ts...> and std::tuple<Ts...> qualified as Qual meet in a row_ref
+    // to the fields qualified as both, like std::tuple does from C++23 on
+    template<typename... Ts, template<typename> class RefQual, template<typename> class Qual>
+    struct basic_common_reference<ksv::detail::row_ref<Ts...>, tuple<remove_const_t<Ts>...>, RefQual, Qual>
+    {
+        using type = ksv::detail::row_ref<remove_reference_t<common_reference_t<Ts &, Qual<remove_const_t<Ts>>>>...>;
+    };
+
+    template<typename... Ts, template<typename> class Qual, template<typename> class RefQual>
+    struct basic_common_reference<tuple<remove_const_t<Ts>...>, ksv::detail::row_ref<Ts...>, Qual, RefQual>
+        : basic_common_reference<ksv::detail::row_ref<Ts...>, tuple<remove_const_t<Ts>...>, RefQual, Qual>
+    {
+    };
+
+    template<typename... Ts>
+    struct tuple_size<ksv::detail::row_ref<Ts...>> : integral_constant<size_t, sizeof...(Ts)>
+    {
+    };
+
+    template<size_t I, typename... Ts>
+    struct tuple_element<I, ksv::detail::row_ref<Ts...>> : tuple_element<I, tuple<Ts &...>>
+    {
+    };
+
+}// namespace std
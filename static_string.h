@@ -0,0 +1,472 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ksv
+{
+
+    // Fixed-capacity, always null-terminated string of up to N characters.
+    // While N fits in one CharT, the size is not stored separately: the last
+    // element of the buffer holds the remaining capacity N - size(), which
+    // is zero, and so doubles as the terminator, exactly when the string is full.
+    template<typename CharT, std::size_t N, typename Traits = std::char_traits<CharT>>
+    class basic_static_string
+    {
+    public:
+        // type aliases
+        using traits_type = Traits;
+        using value_type = CharT;
+        using reference = CharT &;
+        using const_reference = const CharT &;
+        using pointer = CharT *;
+        using const_pointer = const CharT *;
+        using iterator = CharT *;
+        using const_iterator = const CharT *;
+        using riterator = std::reverse_iterator<iterator>;
+        using const_riterator = std::reverse_iterator<const_iterator>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using view_type = std::basic_string_view<CharT, Traits>;
+
+        static constexpr size_type npos = view_type::npos;
+
+        // ctors
+        constexpr basic_static_string() noexcept
+        {
+            set_size(0);
+        }
+
+        constexpr basic_static_string(const CharT *str) : basic_static_string(view_type(str)) {}
+
+        constexpr explicit basic_static_string(view_type str)
+        {
+            set_size(0);
+            append(str);
+        }
+
+        constexpr basic_static_string(size_type count, CharT ch)
+        {
+            set_size(0);
+            append(count, ch);
+        }
+
+        template<std::input_iterator Iter>
+        constexpr basic_static_string(Iter begin, Iter end)
+        {
+            set_size(0);
+            for (; begin != end; ++begin)
+                push_back(*begin);
+        }
+
+        basic_static_string(std::nullptr_t) = delete;
+
+        // non-mutating functions
+        [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            if constexpr (size_in_buffer)
+                return N - static_cast<std::make_unsigned_t<CharT>>(chars()[N]);
+            else
+                return curr_size;
+        }
+
+        [[nodiscard]] constexpr size_type length() const noexcept { return size(); }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return N; }
+
+        [[nodiscard]] constexpr size_type max_size() const noexcept { return N; }
+
+        // validated element access
+        constexpr const_reference at(size_type pos) const
+        {
+            validate_index(pos);
+            return chars()[pos];
+        }
+
+        constexpr reference at(size_type pos)
+        {
+            validate_index(pos);
+            return chars()[pos];
+        }
+
+        // non-validated element access
+        constexpr const_reference operator[](size_type pos) const { return chars()[pos]; }
+
+        constexpr reference operator[](size_type pos) { return chars()[pos]; }
+
+        constexpr const_reference front() const { return chars()[0]; }
+
+        constexpr reference front() { return chars()[0]; }
+
+        constexpr const_reference back() const { return chars()[size() - 1]; }
+
+        constexpr reference back() { return chars()[size() - 1]; }
+
+        // iterators
+        constexpr iterator begin() noexcept { return chars(); }
+
+        constexpr riterator rbegin() noexcept { return riterator(end()); }
+
+        constexpr const_iterator begin() const noexcept { return chars(); }
+
+        constexpr const_riterator rbegin() const noexcept { return const_riterator(end()); }
+
+        constexpr iterator end() noexcept { return chars() + size(); }
+
+        constexpr riterator rend() noexcept { return riterator(begin()); }
+
+        constexpr const_iterator end() const noexcept { return chars() + size(); }
+
+        constexpr const_riterator rend() const noexcept { return const_riterator(begin()); }
+
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+        constexpr const_riterator crbegin() const noexcept { return rbegin(); }
+
+        constexpr const_iterator cend() const noexcept { return end(); }
+
+        constexpr const_riterator crend() const noexcept { return rend(); }
+
+        // underlying buffer access
+        constexpr pointer data() noexcept { return chars(); }
+
+        constexpr const_pointer data() const noexcept { return chars(); }
+
+        constexpr const_pointer c_str() const noexcept { return chars(); }
+
+        constexpr operator view_type() const noexcept { return view_type(chars(), size()); }
+
+        constexpr view_type view() const noexcept { return *this; }
+
+        // searching
+        constexpr size_type find(CharT ch, size_type pos = 0) const noexcept
+        {
+#if defined(__SSE2__)
+            if constexpr (simd_search)
+                if (!std::is_constant_evaluated())
+                    return find_char_simd(ch, pos);
+#endif
+            return view().find(ch, pos);
+        }
+
+        constexpr size_type find(view_type str, size_type pos = 0) const noexcept
+        {
+#if defined(__SSE2__)
+            if constexpr (simd_search)
+                if (!std::is_constant_evaluated() && str.size() > 1)
+                    return find_str_simd(str, pos);
+#endif
+            if (str.size() == 1)
+                return find(str[0], pos);
+            return view().find(str, pos);
+        }
+
+        constexpr size_type rfind(CharT ch, size_type pos = npos) const noexcept { return view().rfind(ch, pos); }
+
+        constexpr size_type rfind(view_type str, size_type pos = npos) const noexcept { return view().rfind(str, pos); }
+
+        constexpr bool contains(CharT ch) const noexcept { return find(ch) != npos; }
+
+        constexpr bool contains(view_type str) const noexcept { return find(str) != npos; }
+
+        constexpr bool starts_with(view_type str) const noexcept { return view().starts_with(str); }
+
+        constexpr bool ends_with(view_type str) const noexcept { return view().ends_with(str); }
+
+        constexpr view_type substr(size_type pos = 0, size_type count = npos) const { return view().substr(pos, count); }
+
+        // comparison, traits compare is memcmp for char which is already vectorized
+        constexpr int compare(view_type str) const noexcept { return view().compare(str); }
+
+        // mutating functions
+        // addition
+        constexpr void push_back(CharT ch)
+        {
+            validate_free(1);
+            const size_type len{size()};
+            chars()[len] = ch;
+            set_size(len + 1);
+        }
+
+        constexpr basic_static_string &append(view_type str)
+        {
+            validate_free(str.size());
+            const size_type len{size()};
+            traits_type::copy(chars() + len, str.data(), str.size());
+            set_size(len + str.size());
+            return *this;
+        }
+
+        constexpr basic_static_string &append(size_type count, CharT ch)
+        {
+            validate_free(count);
+            const size_type len{size()};
+            traits_type::assign(chars() + len, count, ch);
+            set_size(len + count);
+            return *this;
+        }
+
+        // appends the std::to_chars representation of value
+        template<typename Number>
+        basic_static_string &append_number(Number value)
+            requires std::is_same_v<CharT, char>
+        {
+            const size_type len{size()};
+            const auto [end_ptr, error]{std::to_chars(chars() + len, chars() + N, value)};
+            if (error != std::errc())
+                KSV_THROW(std::length_error("Reached max capacity."), "Reached max capacity.");
+            set_size(static_cast<size_type>(end_ptr - chars()));
+            return *this;
+        }
+
+        constexpr basic_static_string &operator+=(view_type str) { return append(str); }
+
+        constexpr basic_static_string &operator+=(CharT ch)
+        {
+            push_back(ch);
+            return *this;
+        }
+
+        constexpr basic_static_string &assign(view_type str)
+        {
+            clear();
+            return append(str);
+        }
+
+        // removal
+        constexpr void pop_back() { set_size(size() - 1); }
+
+        constexpr void clear() noexcept { set_size(0); }
+
+        // resizing
+        constexpr void resize(size_type count, CharT ch = CharT())
+        {
+            const size_type len{size()};
+            if (count <= len)
+                set_size(count);
+            else
+                append(count - len, ch);
+        }
+
+        // lets op write up to count characters straight into the buffer;
+        // op(pointer, count) returns the resulting size
+        template<typename Operation>
+        constexpr void resize_and_overwrite(size_type count, Operation op)
+        {
+            validate_count(count);
+            const auto new_size{static_cast<size_type>(std::move(op)(chars(), count))};
+            validate_count(new_size);
+            set_size(new_size);
+        }
+
+        // swap
+        friend constexpr void swap(basic_static_string &lhs, basic_static_string &rhs) noexcept
+        {
+            basic_static_string tmp{lhs};
+            lhs = rhs;
+            rhs = tmp;
+        }
+
+        // comparison operators
+        friend constexpr bool operator==(const basic_static_string &lhs, view_type rhs) noexcept
+        {
+            return lhs.view() == rhs;
+        }
+
+        friend constexpr auto operator<=>(const basic_static_string &lhs, view_type rhs) noexcept
+        {
+            return lhs.view() <=> rhs;
+        }
+
+        // exact match for literals, which would otherwise convert to view_type
+        // and basic_static_string alike
+        friend constexpr bool operator==(const basic_static_string &lhs, const CharT *rhs) noexcept
+        {
+            return lhs.view() == view_type(rhs);
+        }
+
+        friend constexpr auto operator<=>(const basic_static_string &lhs, const CharT *rhs) noexcept
+        {
+            return lhs.view() <=> view_type(rhs);
+        }
+
+        friend constexpr bool operator==(const basic_static_string &lhs, const basic_static_string &rhs) noexcept
+        {
+            return lhs.view() == rhs.view();
+        }
+
+        friend constexpr auto operator<=>(const basic_static_string &lhs, const basic_static_string &rhs) noexcept
+        {
+            return lhs.view() <=> rhs.view();
+        }
+
+        // concatenation
+        friend constexpr basic_static_string operator+(basic_static_string lhs, view_type rhs)
+        {
+            return lhs.append(rhs);
+        }
+
+    private:
+        // the size lives in the buffer while the remaining capacity fits in a CharT
+        static constexpr bool size_in_buffer = N <= std::numeric_limits<std::make_unsigned_t<CharT>>::max();
+
+        // capacities from which find switches to vector instructions
+        static constexpr bool simd_search = sizeof(CharT) == 1 && N >= 32;
+
+        struct no_size
+        {
+        };
+
+        // instance fields
+        // N characters plus the terminator / remaining capacity
+        detail::constexpr_storage<CharT, N + 1> storage;
+        [[no_unique_address]] std::conditional_t<size_in_buffer, no_size, detail::size_for<N>> curr_size{};
+
+        constexpr pointer chars() noexcept { return storage.ptr(); }
+
+        constexpr const_pointer chars() const noexcept { return storage.ptr(); }
+
+        // writes the terminator and records the size
+        constexpr void set_size(size_type new_size) noexcept
+        {
+            chars()[new_size] = CharT();
+            if constexpr (size_in_buffer)
+                chars()[N] = static_cast<CharT>(N - new_size);
+            else
+                curr_size = static_cast<detail::size_for<N>>(new_size);
+        }
+
+        // methods for validation
+        constexpr void validate_index(size_type index) const
+        {
+            if (index >= size())
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+        }
+
+        constexpr void validate_count(size_type count) const
+        {
+            if (count > N)
+                KSV_THROW(std::length_error("Reached max capacity."), "Reached max capacity.");
+        }
+
+        constexpr void validate_free(size_type count) const
+        {
+            if (count > N - size())
+                KSV_THROW(std::length_error("Reached max capacity."), "Reached max capacity.");
+        }
+
+#if defined(__SSE2__)
+        // loads 16 characters at pos, the caller keeps pos + 16 within the N + 1 element buffer
+        __m128i load16(size_type pos) const noexcept
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(chars() + pos));
+        }
+
+        // bits for the first count lanes of a 16 lane mask
+        static unsigned lanes(size_type count) noexcept
+        {
+            return count >= 16 ? 0xFFFFu : (1u << count) - 1;
+        }
+
+        // since the capacity is known, whole 16 character blocks may be read
+        // past size() as long as they stay inside the buffer; the lanes past
+        // size() are masked off
+        size_type find_char_simd(CharT ch, size_type pos) const noexcept
+        {
+            const size_type len{size()};
+            const __m128i needle{_mm_set1_epi8(static_cast<char>(ch))};
+            for (; pos < len && pos + 16 <= N + 1; pos += 16)
+            {
+                const auto mask{static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(load16(pos), needle))) & lanes(len - pos)};
+                if (mask != 0)
+                    return pos + static_cast<size_type>(std::countr_zero(mask));
+            }
+            return pos < len ? view().find(ch, pos) : npos;
+        }
+
+        // compares the first and last character of str at 16 candidate
+        // positions at once and only runs a full comparison on double hits
+        size_type find_str_simd(view_type str, size_type pos) const noexcept
+        {
+            const size_type len{size()};
+            const size_type count{str.size()};
+            if (count > len || pos > len - count)
+                return npos;
+
+            const __m128i first{_mm_set1_epi8(static_cast<char>(str.front()))};
+            const __m128i last{_mm_set1_epi8(static_cast<char>(str.back()))};
+            const size_type candidates{len - count + 1};
+            for (; pos < candidates && pos + count - 1 + 16 <= N + 1; pos += 16)
+            {
+                const __m128i hits{_mm_and_si128(_mm_cmpeq_epi8(load16(pos), first), _mm_cmpeq_epi8(load16(pos + count - 1), last))};
+                auto mask{static_cast<unsigned>(_mm_movemask_epi8(hits)) & lanes(candidates - pos)};
+                for (; mask != 0; mask &= mask - 1)
+                {
+                    const size_type at{pos + static_cast<size_type>(std::countr_zero(mask))};
+                    if (traits_type::compare(chars() + at + 1, str.data() + 1, count - 2) == 0)
+                        return at;
+                }
+            }
+            return pos < candidates ? view().find(str, pos) : npos;
+        }
+#endif
+    };
+
+    // type aliases
+    template<std::size_t N>
+    using static_string = basic_static_string<char, N>;
+
+    template<std::size_t N>
+    using static_wstring = basic_static_string<wchar_t, N>;
+
+    template<std::size_t N>
+    using static_u8string = basic_static_string<char8_t, N>;
+
+}// namespace ksv
+
+template<typename CharT, std::size_t N, typename Traits>
+struct std::hash<ksv::basic_static_string<CharT, N, Traits>>
+{
+    std::size_t operator()(const ksv::basic_static_string<CharT, N, Traits> &str) const noexcept
+    {
+        return std::hash<std::basic_string_view<CharT, Traits>>{}(str);
+    }
+};
+
+#if defined(__cpp_lib_format)
+// formats like the equivalent string_view, accepting the same format specs
+template<typename CharT, std::size_t N, typename Traits>
+struct std::formatter<ksv::basic_static_string<CharT, N, Traits>, CharT> : std::formatter<std::basic_string_view<CharT, Traits>, CharT>
+{
+    template<typename FormatContext>
+    auto format(const ksv::basic_static_string<CharT, N, Traits> &str, FormatContext &ctx) const
+    {
+        return std::formatter<std::basic_string_view<CharT, Traits>, CharT>::format(str.view(), ctx);
+    }
+};
+#endif
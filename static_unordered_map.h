@@ -0,0 +1,594 @@
+#pragma once
+
+#include "static_vector.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ksv
+{
+
+    // Fixed-capacity hash map of up to N elements stored in place.
+    // Slots carry a control byte holding 7 bits of the hash, or marking the
+    // slot empty; a lookup compares 16 control bytes at once and only checks
+    // keys whose bits match. Collisions are resolved by linear probing, and
+    // erasure shifts the following elements back instead of leaving
+    // tombstones, so no slot between an element and its home slot is empty.
+    // Every insertion and erasure invalidates iterators.
+    template<typename K, typename V, std::size_t N, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+    class static_unordered_map
+    {
+        static_assert(N > 0, "static_unordered_map needs a non-zero capacity.");
+
+        template<bool Const>
+        class basic_iterator;
+
+    public:
+        // type aliases
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<const K, V>;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using pointer = value_type *;
+        using const_pointer = const value_type *;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        // ctors
+        static_unordered_map() noexcept
+        {
+            std::memset(ctrl, empty_ctrl, sizeof(ctrl));
+        }
+
+        // the bucket count is fixed by N, the hint is only taken for
+        // compatibility with std::unordered_map
+        explicit static_unordered_map(size_type /*bucket_count*/, const Hash &hash_fn = Hash(), const KeyEqual &equal_fn = KeyEqual())
+            : hash(hash_fn), equal(equal_fn)
+        {
+            std::memset(ctrl, empty_ctrl, sizeof(ctrl));
+        }
+
+        template<std::input_iterator Iter>
+        static_unordered_map(Iter first, Iter last, size_type bucket_count = 0, const Hash &hash_fn = Hash(), const KeyEqual &equal_fn = KeyEqual())
+            : static_unordered_map(bucket_count, hash_fn, equal_fn)
+        {
+            KSV_TRY
+            {
+                for (; first != last; ++first)
+                    emplace(*first);
+            }
+            KSV_CATCH_ALL
+            {
+                clear();
+                KSV_RETHROW;
+            }
+        }
+
+        static_unordered_map(std::initializer_list<value_type> list, size_type bucket_count = 0, const Hash &hash_fn = Hash(), const KeyEqual &equal_fn = KeyEqual())
+            : static_unordered_map(list.begin(), list.end(), bucket_count, hash_fn, equal_fn)
+        {}
+
+        // the functors are copied on moves as well, other stays usable
+        static_unordered_map(const static_unordered_map &other) : static_unordered_map(slot_count, other.hash, other.equal)
+        {
+            copy_from(other);
+        }
+
+        static_unordered_map(static_unordered_map &&other) noexcept(nothrow_move)
+            : static_unordered_map(slot_count, other.hash, other.equal)
+        {
+            take_elements(other);
+        }
+
+        // assignments
+        static_unordered_map &operator=(const static_unordered_map &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                hash = other.hash;
+                equal = other.equal;
+                copy_from(other);
+            }
+            return *this;
+        }
+
+        static_unordered_map &operator=(static_unordered_map &&other) noexcept(nothrow_move)
+        {
+            if (this != &other)
+            {
+                clear();
+                hash = other.hash;
+                equal = other.equal;
+                take_elements(other);
+            }
+            return *this;
+        }
+
+        // dtor
+        ~static_unordered_map()
+        {
+            clear();
+        }
+
+        // non-mutating functions
+        [[nodiscard]] bool empty() const noexcept { return curr_size == 0; }
+
+        [[nodiscard]] bool full() const noexcept { return curr_size == N; }
+
+        [[nodiscard]] size_type size() const noexcept { return curr_size; }
+
+        [[nodiscard]] size_type capacity() const noexcept { return N; }
+
+        [[nodiscard]] size_type bucket_count() const noexcept { return slot_count; }
+
+        hasher hash_function() const { return hash; }
+
+        key_equal key_eq() const { return equal; }
+
+        // iterators
+        iterator begin() noexcept { return iterator(this, next_occupied(0)); }
+
+        const_iterator begin() const noexcept { return const_iterator(this, next_occupied(0)); }
+
+        iterator end() noexcept { return iterator(this, slot_count); }
+
+        const_iterator end() const noexcept { return const_iterator(this, slot_count); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        const_iterator cend() const noexcept { return end(); }
+
+        // lookup
+        iterator find(const K &key) { return iterator(this, find_slot(key)); }
+
+        const_iterator find(const K &key) const { return const_iterator(this, find_slot(key)); }
+
+        bool contains(const K &key) const { return find_slot(key) != slot_count; }
+
+        size_type count(const K &key) const { return contains(key) ? 1 : 0; }
+
+        // validated element access
+        const V &at(const K &key) const
+        {
+            return slot(validated_slot(key))->second;
+        }
+
+        V &at(const K &key)
+        {
+            return slot(validated_slot(key))->second;
+        }
+
+        // inserting element access, fails like emplace when full
+        V &operator[](const K &key) { return validated(try_emplace(key)).first->second; }
+
+        V &operator[](K &&key) { return validated(try_emplace(std::move(key))).first->second; }
+
+        // mutating functions
+        // addition
+        // constructs the value only if key is absent; when the map is full and
+        // key is absent nothing is inserted and the iterator is end()
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const K &key, Args &&...args)
+        {
+            return try_emplace_internal(key, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(K &&key, Args &&...args)
+        {
+            return try_emplace_internal(std::move(key), std::forward<Args>(args)...);
+        }
+
+        // the throwing insertions, failing with length_error when full
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args &&...args)
+        {
+            std::pair<K, V> elem(std::forward<Args>(args)...);
+            return validated(try_emplace_internal(std::move(elem.first), std::move(elem.second)));
+        }
+
+        std::pair<iterator, bool> insert(const value_type &elem)
+        {
+            return validated(try_emplace_internal(elem.first, elem.second));
+        }
+
+        std::pair<iterator, bool> insert(value_type &&elem)
+        {
+            return validated(try_emplace_internal(elem.first, std::move(elem.second)));
+        }
+
+        template<std::input_iterator Iter>
+        void insert(Iter first, Iter last)
+        {
+            for (; first != last; ++first)
+                emplace(*first);
+        }
+
+        void insert(std::initializer_list<value_type> list)
+        {
+            insert(list.begin(), list.end());
+        }
+
+        template<typename Obj>
+        std::pair<iterator, bool> insert_or_assign(const K &key, Obj &&obj)
+        {
+            auto result{validated(try_emplace_internal(key, std::forward<Obj>(obj)))};
+            if (!result.second)
+                result.first->second = std::forward<Obj>(obj);
+            return result;
+        }
+
+        template<typename Obj>
+        std::pair<iterator, bool> insert_or_assign(K &&key, Obj &&obj)
+        {
+            auto result{validated(try_emplace_internal(std::move(key), std::forward<Obj>(obj)))};
+            if (!result.second)
+                result.first->second = std::forward<Obj>(obj);
+            return result;
+        }
+
+        // removal
+        // no iterator is returned, shifting back may move an element that
+        // was already visited in front of pos
+        void erase(const_iterator pos)
+        {
+            erase_slot(pos.idx);
+        }
+
+        size_type erase(const K &key)
+        {
+            const size_type idx{find_slot(key)};
+            if (idx == slot_count)
+                return 0;
+            erase_slot(idx);
+            return 1;
+        }
+
+        void clear() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<value_type>)
+                for (size_type i{next_occupied(0)}; i < slot_count; i = next_occupied(i + 1))
+                    std::destroy_at(slot(i));
+            std::memset(ctrl, empty_ctrl, sizeof(ctrl));
+            curr_size = 0;
+        }
+
+        // swap
+        friend void swap(static_unordered_map &lhs, static_unordered_map &rhs)
+        {
+            static_unordered_map tmp{std::move(lhs)};
+            lhs = std::move(rhs);
+            rhs = std::move(tmp);
+        }
+
+        // comparison operators
+        friend bool operator==(const static_unordered_map &lhs, const static_unordered_map &rhs)
+        {
+            if (lhs.size() != rhs.size())
+                return false;
+            for (const auto &[key, value] : lhs)
+            {
+                const size_type idx{rhs.find_slot(key)};
+                if (idx == slot_count || !(rhs.slot(idx)->second == value))
+                    return false;
+            }
+            return true;
+        }
+
+        friend bool operator!=(const static_unordered_map &lhs, const static_unordered_map &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        // control bytes are compared in groups of this many
+        static constexpr size_type group_width{16};
+
+        // a power of two keeping the load at most 7/8, so that probes stay
+        // short and every probe sequence meets an empty slot
+        static constexpr size_type slot_count{std::max(group_width, std::bit_ceil(N + N / 7 + 1))};
+        static constexpr size_type slot_mask{slot_count - 1};
+        static constexpr int slot_bits{std::countr_zero(slot_count)};
+
+        // full slots hold the low 7 hash bits, so only empty has the top bit set
+        static constexpr std::int8_t empty_ctrl{-128};
+
+        // element types that may be copied as raw bytes and need no destruction
+        static constexpr bool trivially_copyable = std::is_trivially_copyable_v<value_type> && std::is_trivially_destructible_v<value_type>;
+        static constexpr bool trivially_relocatable = is_trivially_relocatable_v<K> && is_trivially_relocatable_v<V>;
+        static constexpr bool nothrow_move = (trivially_relocatable || std::is_nothrow_move_constructible_v<value_type>) &&
+                                            std::is_nothrow_copy_constructible_v<Hash> && std::is_nothrow_copy_constructible_v<KeyEqual> &&
+                                            std::is_nothrow_copy_assignable_v<Hash> && std::is_nothrow_copy_assignable_v<KeyEqual>;
+
+        // instance fields
+        // the control bytes of the first group_width - 1 slots are repeated
+        // after the last slot, so a group can be loaded from any position
+        [[no_unique_address]] Hash hash;
+        [[no_unique_address]] KeyEqual equal;
+        detail::size_for<N> curr_size{0};
+        std::int8_t ctrl[slot_count + group_width - 1];
+        detail::byte_storage<value_type, slot_count> slots;
+
+        pointer slot(size_type idx) noexcept { return slots.ptr() + idx; }
+
+        const_pointer slot(size_type idx) const noexcept { return slots.ptr() + idx; }
+
+        // spreads weak hashes such as the identity for integers over all bits
+        std::uint64_t mixed_hash(const K &key) const
+        {
+            return static_cast<std::uint64_t>(hash(key)) * 0x9E3779B97F4A7C15ull;
+        }
+
+        // the top bits pick the home slot, the low 7 bits are kept in ctrl
+        static size_type home_slot(std::uint64_t mixed) noexcept
+        {
+            return static_cast<size_type>(mixed >> (64 - slot_bits));
+        }
+
+        static std::int8_t tag_of(std::uint64_t mixed) noexcept
+        {
+            return static_cast<std::int8_t>(mixed & 0x7F);
+        }
+
+        void set_ctrl(size_type idx, std::int8_t value) noexcept
+        {
+            ctrl[idx] = value;
+            if (idx < group_width - 1)
+                ctrl[idx + slot_count] = value;
+        }
+
+        // one bit per slot of the group at pos whose control byte is value
+        unsigned match_group(size_type pos, std::int8_t value) const noexcept
+        {
+#if defined(__SSE2__)
+            const __m128i group{_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl + pos))};
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value))));
+#else
+            unsigned mask{0};
+            for (size_type i{0}; i < group_width; ++i)
+                mask |= static_cast<unsigned>(ctrl[pos + i] == value) << i;
+            return mask;
+#endif
+        }
+
+        // slot holding key, or slot_count when absent
+        size_type find_slot(const K &key) const
+        {
+            return find_slot(key, mixed_hash(key));
+        }
+
+        // the same for the mixed hash of key, computed once by insertions
+        size_type find_slot(const K &key, std::uint64_t mixed) const
+        {
+            const std::int8_t tag{tag_of(mixed)};
+            for (size_type pos{home_slot(mixed)};; pos = (pos + group_width) & slot_mask)
+            {
+                unsigned matches{match_group(pos, tag)};
+                const unsigned empties{match_group(pos, empty_ctrl)};
+                if (empties != 0)
+                    matches &= (empties & (0u - empties)) - 1;// probing ends at the first empty slot
+                for (; matches != 0; matches &= matches - 1)
+                {
+                    const size_type idx{(pos + static_cast<size_type>(std::countr_zero(matches))) & slot_mask};
+                    if (equal(slot(idx)->first, key))
+                        return idx;
+                }
+                if (empties != 0)
+                    return slot_count;
+            }
+        }
+
+        // first empty slot at or after the home slot of mixed
+        size_type free_slot(std::uint64_t mixed) const noexcept
+        {
+            for (size_type pos{home_slot(mixed)};; pos = (pos + group_width) & slot_mask)
+            {
+                const unsigned empties{match_group(pos, empty_ctrl)};
+                if (empties != 0)
+                    return (pos + static_cast<size_type>(std::countr_zero(empties))) & slot_mask;
+            }
+        }
+
+        size_type next_occupied(size_type idx) const noexcept
+        {
+            while (idx < slot_count && ctrl[idx] == empty_ctrl)
+                ++idx;
+            return idx;
+        }
+
+        // methods for validation
+        size_type validated_slot(const K &key) const
+        {
+            const size_type idx{find_slot(key)};
+            if (idx == slot_count)
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
+            return idx;
+        }
+
+        std::pair<iterator, bool> validated(std::pair<iterator, bool> result) const
+        {
+            if (result.first.idx == slot_count)
+                KSV_THROW(std::length_error("Reached max capacity."), "Reached max capacity.");
+            return result;
+        }
+
+        template<typename KeyArg, typename... Args>
+        std::pair<iterator, bool> try_emplace_internal(KeyArg &&key, Args &&...args)
+        {
+            const std::uint64_t mixed{mixed_hash(key)};
+            const size_type found{find_slot(key, mixed)};
+            if (found != slot_count)
+                return {iterator(this, found), false};
+            if (curr_size == N)
+                return {end(), false};
+
+            const size_type idx{free_slot(mixed)};
+            std::construct_at(slot(idx), std::piecewise_construct, std::forward_as_tuple(std::forward<KeyArg>(key)),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+            set_ctrl(idx, tag_of(mixed));
+            ++curr_size;
+            return {iterator(this, idx), true};
+        }
+
+        // moves the element in from to the empty slot to
+        void relocate_slot(size_type from, size_type to)
+        {
+            if constexpr (trivially_relocatable)
+                std::memcpy(static_cast<void *>(slot(to)), slot(from), sizeof(value_type));
+            else
+            {
+                std::construct_at(slot(to), std::move(*slot(from)));
+                std::destroy_at(slot(from));
+            }
+            set_ctrl(to, ctrl[from]);
+        }
+
+        // backward shift deletion: every following element of the probe run
+        // whose home slot is not after the hole moves into it
+        void erase_slot(size_type idx)
+        {
+            std::destroy_at(slot(idx));
+            size_type hole{idx};
+            for (size_type next{(idx + 1) & slot_mask}; ctrl[next] != empty_ctrl; next = (next + 1) & slot_mask)
+            {
+                const size_type home{home_slot(mixed_hash(slot(next)->first))};
+                if (((next - hole) & slot_mask) <= ((next - home) & slot_mask))
+                {
+                    relocate_slot(next, hole);
+                    hole = next;
+                }
+            }
+            set_ctrl(hole, empty_ctrl);
+            --curr_size;
+        }
+
+        // elements keep their slots, both maps hash alike
+        void copy_from(const static_unordered_map &other)
+        {
+            if constexpr (trivially_copyable)
+                std::memcpy(static_cast<void *>(slot(0)), other.slot(0), sizeof(slots));
+            else
+            {
+                KSV_TRY
+                {
+                    for (size_type i{other.next_occupied(0)}; i < slot_count; i = other.next_occupied(i + 1))
+                    {
+                        std::construct_at(slot(i), *other.slot(i));
+                        set_ctrl(i, other.ctrl[i]);
+                        ++curr_size;
+                    }
+                }
+                KSV_CATCH_ALL
+                {
+                    clear();
+                    KSV_RETHROW;
+                }
+            }
+            std::memcpy(ctrl, other.ctrl, sizeof(ctrl));
+            curr_size = other.curr_size;
+        }
+
+        // moves all elements out of other into this empty map
+        void take_elements(static_unordered_map &other) noexcept(trivially_relocatable || std::is_nothrow_move_constructible_v<value_type>)
+        {
+            if constexpr (trivially_relocatable)
+            {
+                std::memcpy(static_cast<void *>(slot(0)), other.slot(0), sizeof(slots));
+                std::memcpy(ctrl, other.ctrl, sizeof(ctrl));
+                curr_size = other.curr_size;
+                std::memset(other.ctrl, empty_ctrl, sizeof(other.ctrl));
+                other.curr_size = 0;
+            }
+            else
+            {
+                for (size_type i{other.next_occupied(0)}; i < slot_count; i = other.next_occupied(i + 1))
+                {
+                    std::construct_at(slot(i), std::move(*other.slot(i)));
+                    set_ctrl(i, other.ctrl[i]);
+                    ++curr_size;
+                }
+                other.clear();
+            }
+        }
+
+        // forward iterator over the occupied slots
+        template<bool Const>
+        class basic_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using iterator_concept = std::forward_iterator_tag;
+            using value_type = std::pair<const K, V>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+            using reference = std::conditional_t<Const, const value_type &, value_type &>;
+
+            basic_iterator() noexcept = default;
+
+            // non-const to const conversion
+            template<bool OtherConst>
+                requires(Const && !OtherConst)
+            basic_iterator(const basic_iterator<OtherConst> &other) noexcept : owner(other.owner), idx(other.idx)
+            {}
+
+            reference operator*() const { return *owner->slot(idx); }
+
+            pointer operator->() const { return owner->slot(idx); }
+
+            basic_iterator &operator++() noexcept
+            {
+                idx = owner->next_occupied(idx + 1);
+                return *this;
+            }
+
+            basic_iterator operator++(int) noexcept
+            {
+                basic_iterator tmp{*this};
+                ++*this;
+                return tmp;
+            }
+
+            friend bool operator==(const basic_iterator &lhs, const basic_iterator &rhs) noexcept { return lhs.idx == rhs.idx; }
+
+        private:
+            friend class static_unordered_map;
+            friend class basic_iterator<!Const>;
+
+            using owner_type = std::conditional_t<Const, const static_unordered_map, static_unordered_map>;
+
+            basic_iterator(owner_type *map, size_type pos) noexcept : owner(map), idx(pos) {}
+
+            owner_type *owner{nullptr};
+            size_type idx{0};
+        };
+    };
+
+    template<typename K, typename V, std::size_t N, typename Hash, typename KeyEqual>
+    struct is_trivially_relocatable<static_unordered_map<K, V, N, Hash, KeyEqual>>
+        : std::bool_constant<is_trivially_relocatable_v<K> && is_trivially_relocatable_v<V> &&
+                             std::is_trivially_copyable_v<Hash> && std::is_trivially_copyable_v<KeyEqual>>
+    {
+    };
+
+}// namespace ksv
@@ -1,13 +1,174 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <compare>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <new>
+#include <ranges>
+#include <stdexcept>
 #include <type_traits>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Failures of checked operations throw. When exceptions are disabled they are
+// routed to KSV_FAILURE_HANDLER(message) instead, which may be defined before
+// including this header and must not return; it defaults to std::abort().
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+#define KSV_THROW(exception, message) throw exception
+#define KSV_TRY try
+#define KSV_CATCH_ALL catch (...)
+#define KSV_RETHROW throw
+#else
+#ifndef KSV_FAILURE_HANDLER
+#define KSV_FAILURE_HANDLER(message) std::abort()
+#endif
+#define KSV_THROW(exception, message) KSV_FAILURE_HANDLER(message)
+#define KSV_TRY if constexpr (true)
+#define KSV_CATCH_ALL if constexpr (false)
+#define KSV_RETHROW
+#endif
+
 namespace ksv
 {
 
+    // tag selecting construction from a range
+#if defined(__cpp_lib_containers_ranges)
+    using std::from_range;
+    using std::from_range_t;
+#else
+    struct from_range_t
+    {
+        explicit from_range_t() = default;
+    };
+
+    inline constexpr from_range_t from_range{};
+#endif
+
+    // Types whose objects can be moved to new storage by copying their bytes and
+    // then forgetting the source, without running the move constructor and the
+    // destructor. Specialize for own types that qualify.
+    template<typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>>
+    {
+    };
+
+    template<typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    template<typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+    {
+    };
+
+    namespace detail
+    {
+
+        // element storage for trivially destructible T, an array of T in a
+        // union takes part in constant evaluation, unlike raw bytes reached
+        // through reinterpret_cast, and has no elements until they are constructed
+        template<typename T, std::size_t N>
+        struct constexpr_storage
+        {
+            union
+            {
+                T elems[N];
+            };
+
+            constexpr constexpr_storage() noexcept
+            {
+                // a constexpr variable must not hold indeterminate values,
+                // at runtime the array is left uninitialized; T{} rather than
+                // T() since GCC does not zero-initialize members for the latter
+                if constexpr (std::default_initializable<T> && std::move_constructible<T>)
+                    if (std::is_constant_evaluated())
+                        for (auto &elem : elems)
+                            std::construct_at(&elem, T{});
+            }
+
+            constexpr T *ptr() noexcept { return elems; }
+
+            constexpr const T *ptr() const noexcept { return elems; }
+        };
+
+        // uninitialized element storage for all other T
+        template<typename T, std::size_t N>
+        struct byte_storage
+        {
+            alignas(T) std::byte buffer[sizeof(T) * N];// no objects of type T created yet
+
+            // pointer to object A (since we use pointer to object B providing storage for A)
+            T *ptr() noexcept { return std::launder(reinterpret_cast<T *>(buffer)); }
+
+            const T *ptr() const noexcept { return std::launder(reinterpret_cast<const T *>(buffer)); }
+        };
+
+        template<typename T, std::size_t N>
+        using storage_for = std::conditional_t<std::is_trivially_destructible_v<T>, constexpr_storage<T, N>, byte_storage<T, N>>;
+
+        // smallest unsigned type able to hold every size in [0, N]
+        template<std::size_t N>
+        using size_for = std::conditional_t<N <= UINT8_MAX, std::uint8_t,
+                                            std::conditional_t<N <= UINT16_MAX, std::uint16_t,
+                                                               std::conditional_t<N <= UINT32_MAX, std::uint32_t, std::uint64_t>>>;
+
+        // alignment keeping data written by different threads on separate cache lines
+        inline constexpr std::size_t cache_line_size{64};
+
+        // three-way comparison falling back to < for types without <=>
+        struct synth_three_way
+        {
+            template<typename T, typename U>
+            constexpr auto operator()(const T &lhs, const U &rhs) const
+            {
+                if constexpr (std::three_way_comparable_with<T, U>)
+                    return lhs <=> rhs;
+                else
+                {
+                    if (lhs < rhs)
+                        return std::weak_ordering::less;
+                    if (rhs < lhs)
+                        return std::weak_ordering::greater;
+                    return std::weak_ordering::equivalent;
+                }
+            }
+        };
+
+        // index of the first of count elements whose bytes differ, or count
+        template<typename T>
+        inline std::size_t first_mismatch(const T *lhs, const T *rhs, std::size_t count) noexcept
+        {
+            const auto *lhs_bytes{reinterpret_cast<const unsigned char *>(lhs)};
+            const auto *rhs_bytes{reinterpret_cast<const unsigned char *>(rhs)};
+            const std::size_t bytes{count * sizeof(T)};
+            std::size_t i{0};
+#if defined(__SSE2__)
+            for (; i + 16 <= bytes; i += 16)
+            {
+                const __m128i lhs_block{_mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs_bytes + i))};
+                const __m128i rhs_block{_mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs_bytes + i))};
+                const auto equal{static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs_block, rhs_block)))};
+                if (equal != 0xFFFF)
+                    return (i + static_cast<std::size_t>(std::countr_one(equal))) / sizeof(T);
+            }
+#endif
+            for (; i < bytes; ++i)
+                if (lhs_bytes[i] != rhs_bytes[i])
+                    return i / sizeof(T);
+            return count;
+        }
+
+    }// namespace detail
+
     template<typename T, std::size_t N>
     class static_vector
     {
@@ -26,273 +187,758 @@ namespace ksv
         using size_type = std::size_t;
 
         // ctors
-        static_vector() = default;
+        constexpr static_vector() noexcept = default;
 
-        template<typename Iter>
-        static_vector(Iter begin, Iter end)
+        template<std::input_iterator Iter>
+        constexpr static_vector(Iter begin, Iter end)
+        {
+            append_range(std::ranges::subrange(begin, end));
+        }
+
+        template<std::ranges::input_range R>
+        constexpr static_vector(from_range_t, R &&range)
         {
-            validate_count(std::distance(begin, end));
-            for (auto iter{begin}; iter != end; ++iter)
-                pb_internal(*iter);
+            append_range(std::forward<R>(range));
         }
 
-        static_vector(std::initializer_list<T> list) : static_vector(std::begin(list), std::end(list)){};
+        constexpr static_vector(std::initializer_list<T> list) : static_vector(std::begin(list), std::end(list)){};
 
-        static_vector(size_type count, const T &value)
+        constexpr static_vector(size_type count, const T &value)
         {
-            validate_count(count);
-            for (size_type i{0}; i < count; ++i)
-                pb_internal(value);
+            resize(count, value);
         }
 
-        static_vector(const static_vector &other)
+        constexpr static_vector(const static_vector &other)
         {
+            if constexpr (trivially_copyable)
+            {
+                copy_bytes(other);
+                return;
+            }
+
             // for providing strong exception guarantee
-            try
+            KSV_TRY
             {
                 for (size_t i{0}; i < other.curr_size; ++i)
                     pb_internal(other[i]);
             }
-            catch (...)
+            KSV_CATCH_ALL
             {
                 clear_elements();
-                throw;// make sure exceptions continue propagating
+                KSV_RETHROW;// make sure exceptions continue propagating
             }
         }
 
-        static_vector(static_vector &&other) noexcept : static_vector()
+        constexpr static_vector(static_vector &&other) noexcept
         {
+            if constexpr (trivially_relocatable)
+            {
+                relocate_from(other);
+                return;
+            }
+
             other.swap(*this);
         }
 
+        // moves the elements of a vector with a different capacity, leaving it empty
+        template<std::size_t M>
+        constexpr explicit static_vector(static_vector<T, M> &&other)
+        {
+            validate_count(other.size());
+            if constexpr (trivially_relocatable)
+                relocate_from(other);
+            else
+            {
+                append_range(std::ranges::subrange(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())));
+                other.clear();
+            }
+        }
+
         // assignments
-        static_vector &operator=(const static_vector &other)
+        constexpr static_vector &operator=(const static_vector &other)
         {
+            if constexpr (trivially_copyable)
+            {
+                if (this != &other)
+                    copy_bytes(other);
+                return *this;
+            }
+
             static_vector tmp{other};
             tmp.swap(*this);
             return *this;
         }
 
-        static_vector &operator=(static_vector &&other) noexcept
+        constexpr static_vector &operator=(static_vector &&other) noexcept
         {
+            if constexpr (trivially_relocatable)
+            {
+                if (this != &other)
+                {
+                    clear_elements();
+                    relocate_from(other);
+                }
+                return *this;
+            }
+
             static_vector tmp{std::move(other)};
             tmp.swap(*this);
             return *this;
         }
 
         // dtor
-        ~static_vector()
+        constexpr ~static_vector()
         {
             clear_elements();
         }
 
         // non-mutating functions
-        [[nodiscard]] bool empty() const { return curr_size == 0; }
+        [[nodiscard]] constexpr bool empty() const { return curr_size == 0; }
 
-        [[nodiscard]] size_type size() const { return curr_size; }
+        [[nodiscard]] constexpr size_type size() const { return curr_size; }
 
-        [[nodiscard]] size_type capacity() const { return N; }
+        [[nodiscard]] constexpr size_type capacity() const { return N; }
 
         // validated element access
-        const_reference at(size_type pos) const
+        constexpr const_reference at(size_type pos) const
         {
             validate_index(pos);
             return *cleaned_const_data_ptr(pos);
         }
 
-        reference at(size_type pos)
+        constexpr reference at(size_type pos)
         {
             validate_index(pos);
             return *cleaned_data_ptr(pos);
         }
 
         // non-validated element access
-        const_reference operator[](size_type pos) const { return *cleaned_const_data_ptr(pos); }
+        constexpr const_reference operator[](size_type pos) const { return *cleaned_const_data_ptr(pos); }
 
-        reference operator[](size_type pos) { return *cleaned_data_ptr(pos); }
+        constexpr reference operator[](size_type pos) { return *cleaned_data_ptr(pos); }
 
-        const_reference front() const { return *cleaned_const_data_ptr(); }
+        constexpr const_reference front() const { return *cleaned_const_data_ptr(); }
 
-        reference front() { return *cleaned_data_ptr(); }
+        constexpr reference front() { return *cleaned_data_ptr(); }
 
-        const_reference back() const { return *cleaned_const_data_ptr(curr_size - 1); }
+        constexpr const_reference back() const { return *cleaned_const_data_ptr(curr_size - 1); }
 
-        reference back() { return *cleaned_data_ptr(curr_size - 1); }
+        constexpr reference back() { return *cleaned_data_ptr(curr_size - 1); }
 
         // iterators
-        iterator begin() { return cleaned_data_ptr(); }
+        constexpr iterator begin() { return cleaned_data_ptr(); }
 
-        riterator rbegin() { return riterator(end()); }
+        constexpr riterator rbegin() { return riterator(end()); }
 
-        const_iterator begin() const { return cleaned_const_data_ptr(); }
+        constexpr const_iterator begin() const { return cleaned_const_data_ptr(); }
 
-        const_iterator rbegin() const { return riterator(end()); }
+        constexpr const_riterator rbegin() const { return const_riterator(end()); }
 
-        iterator end() { return cleaned_data_ptr(curr_size); }
+        constexpr iterator end() { return cleaned_data_ptr(curr_size); }
 
-        riterator rend() { return riterator(begin()); }
+        constexpr riterator rend() { return riterator(begin()); }
 
-        const_iterator end() const { return cleaned_const_data_ptr(curr_size); }
+        constexpr const_iterator end() const { return cleaned_const_data_ptr(curr_size); }
 
-        const_riterator rend() const { return riterator(begin()); }
+        constexpr const_riterator rend() const { return const_riterator(begin()); }
 
-        const_iterator cbegin() const { return begin(); }
+        constexpr const_iterator cbegin() const { return begin(); }
 
-        const_riterator crbegin() const { return rbegin(); }
+        constexpr const_riterator crbegin() const { return rbegin(); }
 
-        const_iterator cend() const { return end(); }
+        constexpr const_iterator cend() const { return end(); }
 
-        const_riterator crend() const { return rend(); }
+        constexpr const_riterator crend() const { return rend(); }
 
         // underlying buffer access
-        pointer data() noexcept { return cleaned_data_ptr(); }
+        constexpr pointer data() noexcept { return cleaned_data_ptr(); }
 
-        const_pointer data() const noexcept { return cleaned_const_data_ptr(); }
+        constexpr const_pointer data() const noexcept { return cleaned_const_data_ptr(); }
 
         // mutating functions
         // addition
-        void push_back(const_reference value)
+        constexpr void push_back(const_reference value)
         {
             validate_curr_size();
             pb_internal(value);
         }
 
-        void push_back(value_type &&value)
+        constexpr void push_back(value_type &&value)
         {
             validate_curr_size();
             mb_internal(std::move(value));
         }
 
         template<typename... Args>
-        void emplace_back(Args &&...args)
+        constexpr void emplace_back(Args &&...args)
         {
             validate_curr_size();
             eb_internal(std::forward<Args>(args)...);
         }
 
+        // non-throwing addition, returns nullptr when full
+        constexpr pointer try_push_back(const_reference value)
+        {
+            return try_emplace_back(value);
+        }
+
+        constexpr pointer try_push_back(value_type &&value)
+        {
+            return try_emplace_back(std::move(value));
+        }
+
+        template<typename... Args>
+        constexpr pointer try_emplace_back(Args &&...args)
+        {
+            if (curr_size >= N)
+                return nullptr;
+            eb_internal(std::forward<Args>(args)...);
+            return cleaned_data_ptr(curr_size - 1);
+        }
+
+        // appends until range or capacity is exhausted, returns the first element not appended
+        template<std::ranges::input_range R>
+        constexpr std::ranges::borrowed_iterator_t<R> try_append_range(R &&range)
+        {
+            auto iter{std::ranges::begin(range)};
+            const auto last{std::ranges::end(range)};
+            for (; curr_size < N && iter != last; ++iter)
+                eb_internal(*iter);
+            return iter;
+        }
+
+        // unvalidated addition, capacity is only asserted in debug builds
+        constexpr reference unchecked_push_back(const_reference value)
+        {
+            return unchecked_emplace_back(value);
+        }
+
+        constexpr reference unchecked_push_back(value_type &&value)
+        {
+            return unchecked_emplace_back(std::move(value));
+        }
+
+        template<typename... Args>
+        constexpr reference unchecked_emplace_back(Args &&...args)
+        {
+            assert(curr_size < N);
+            eb_internal(std::forward<Args>(args)...);
+            return back();
+        }
+
+        template<std::ranges::input_range R>
+        constexpr void append_range(R &&range)
+        {
+            const size_type old_size{curr_size};
+            KSV_TRY
+            {
+                if constexpr (std::ranges::sized_range<R>)
+                    append_counted(std::ranges::begin(range), static_cast<size_type>(std::ranges::size(range)));
+                else
+                    append_internal(std::ranges::begin(range), std::ranges::end(range));
+            }
+            KSV_CATCH_ALL
+            {
+                truncate(old_size);
+                KSV_RETHROW;
+            }
+        }
+
+        template<typename... Args>
+        constexpr iterator emplace(const_iterator pos, Args &&...args)
+        {
+            validate_curr_size();
+            const size_type idx{index_of(pos)};
+            if constexpr (trivially_relocatable)
+            {
+                // args may refer to an element that is about to be shifted
+                T value(std::forward<Args>(args)...);
+                insert_relocating(idx, 1, [&value](pointer p) { std::construct_at(p, std::move(value)); });
+            }
+            else
+            {
+                eb_internal(std::forward<Args>(args)...);
+                std::rotate(begin() + idx, end() - 1, end());
+            }
+            return begin() + idx;
+        }
+
+        constexpr iterator insert(const_iterator pos, const_reference value)
+        {
+            return emplace(pos, value);
+        }
+
+        constexpr iterator insert(const_iterator pos, value_type &&value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        constexpr iterator insert(const_iterator pos, size_type count, const_reference value)
+        {
+            validate_free(count);
+            const size_type idx{index_of(pos)};
+            if constexpr (trivially_relocatable)
+            {
+                const T copy{value};
+                insert_relocating(idx, count, [&copy](pointer p) { std::construct_at(p, copy); });
+                return begin() + idx;
+            }
+
+            const size_type old_size{curr_size};
+            KSV_TRY
+            {
+                for (size_type i{0}; i < count; ++i)
+                    pb_internal(value);
+            }
+            KSV_CATCH_ALL
+            {
+                truncate(old_size);
+                KSV_RETHROW;
+            }
+            std::rotate(begin() + idx, begin() + old_size, end());
+            return begin() + idx;
+        }
+
+        template<std::input_iterator Iter>
+        constexpr iterator insert(const_iterator pos, Iter first, Iter last)
+        {
+            const size_type idx{index_of(pos)};
+            if constexpr (trivially_relocatable && std::forward_iterator<Iter>)
+            {
+                const auto count{static_cast<size_type>(std::distance(first, last))};
+                validate_free(count);
+                insert_relocating(idx, count, [&first](pointer p) { std::construct_at(p, *first++); });
+                return begin() + idx;
+            }
+
+            // append in one pass, then rotate the new elements into place
+            const size_type old_size{curr_size};
+            append_range(std::ranges::subrange(first, last));
+            std::rotate(begin() + idx, begin() + old_size, end());
+            return begin() + idx;
+        }
+
+        constexpr iterator insert(const_iterator pos, std::initializer_list<T> list)
+        {
+            return insert(pos, list.begin(), list.end());
+        }
+
         // removal
-        void pop_back()
+        constexpr void pop_back()
         {
             --curr_size;
             std::destroy_at(cleaned_data_ptr(curr_size));
         }
 
-        void clear()
+        constexpr iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        constexpr iterator erase(const_iterator first, const_iterator last)
+        {
+            const size_type idx{index_of(first)};
+            const size_type count{index_of(last) - idx};
+            if (count == 0)
+                return begin() + idx;
+
+            if constexpr (trivially_relocatable)
+            {
+                std::destroy(cleaned_data_ptr(idx), cleaned_data_ptr(idx + count));
+                move_raw(cleaned_data_ptr(idx + count), curr_size - idx - count, cleaned_data_ptr(idx));
+                curr_size -= count;
+            }
+            else
+            {
+                std::move(begin() + idx + count, end(), begin() + idx);
+                truncate(curr_size - count);
+            }
+            return begin() + idx;
+        }
+
+        constexpr void clear()
         {
             clear_elements();
         }
 
-        // swap
-        friend void swap(static_vector &lhs, static_vector &rhs)
+        // resizing
+        constexpr void resize(size_type count)
         {
-            lhs.swap(rhs);
+            resize_internal(count, [this] { eb_internal(); });
         }
 
-        // comparison operators
-        friend inline bool operator==(const static_vector &lhs, const static_vector &rhs)
+        constexpr void resize(size_type count, const_reference value)
+        {
+            resize_internal(count, [this, &value] { pb_internal(value); });
+        }
+
+        // like std::basic_string::resize_and_overwrite: op(data(), count)
+        // writes the first elements and returns how many of them to keep,
+        // with the ones past the old size left indeterminate instead of
+        // value-initialized until op writes them
+        template<typename Operation>
+            requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+        constexpr void resize_and_overwrite(size_type count, Operation op)
+        {
+            validate_count(count);
+            const size_type new_size{static_cast<size_type>(std::move(op)(data(), count))};
+            assert(new_size <= count);
+            curr_size = static_cast<detail::size_for<N>>(new_size);
+        }
+
+        // assignment of new contents
+        constexpr void assign(size_type count, const_reference value)
         {
-            return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+            validate_count(count);
+            const size_type common{std::min<size_type>(count, curr_size)};
+            std::fill_n(begin(), common, value);
+            if (count < curr_size)
+                truncate(count);
+            else
+                while (curr_size < count)
+                    pb_internal(value);
         }
 
-        friend inline bool operator!=(const static_vector &lhs, const static_vector &rhs)
+        template<std::input_iterator Iter>
+        constexpr void assign(Iter first, Iter last)
         {
-            return !(lhs == rhs);
+            assign_internal(first, last);
         }
 
-        friend inline bool operator<(const static_vector &lhs, const static_vector &rhs)
+        template<std::ranges::input_range R>
+        constexpr void assign_range(R &&range)
         {
-            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+            assign_internal(std::ranges::begin(range), std::ranges::end(range));
         }
 
-        friend inline bool operator>(const static_vector &lhs, const static_vector &rhs)
+        constexpr void assign(std::initializer_list<T> list)
         {
-            return rhs < lhs;
+            assign(list.begin(), list.end());
+        }
+
+        // swap
+        friend constexpr void swap(static_vector &lhs, static_vector &rhs)
+        {
+            lhs.swap(rhs);
         }
 
-        friend inline bool operator<=(const static_vector &lhs, const static_vector &rhs)
+        // comparison operators
+        friend constexpr bool operator==(const static_vector &lhs, const static_vector &rhs)
         {
-            return !(lhs > rhs);
+            if (lhs.size() != rhs.size())
+                return false;
+            if constexpr (bytewise_comparable)
+                if (!std::is_constant_evaluated())
+                    return std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0;
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin());
         }
 
-        friend inline bool operator>=(const static_vector &lhs, const static_vector &rhs)
+        // ordered like std::vector, by T's <=> or else by its <
+        friend constexpr auto operator<=>(const static_vector &lhs, const static_vector &rhs)
         {
-            return !(lhs < rhs);
+            if constexpr (bytewise_comparable)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    // only the first element whose bytes differ needs a real comparison
+                    const size_type common{std::min(lhs.size(), rhs.size())};
+                    const size_type idx{detail::first_mismatch(lhs.data(), rhs.data(), common)};
+                    if (idx != common)
+                        return lhs[idx] <=> rhs[idx];
+                    return lhs.size() <=> rhs.size();
+                }
+            }
+            return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), detail::synth_three_way{});
         }
 
     private:
         // instance fields
-        alignas(T) std::byte buffer[sizeof(T) * N];// no objects of type T created yet
-        size_type curr_size{0};
+        // narrowest size type, kept after the elements so it only adds alignment padding
+        detail::storage_for<T, N> storage;
+        detail::size_for<N> curr_size{0};
+
+        // element types that may be copied as raw bytes and need no destruction
+        static constexpr bool trivially_copyable = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+
+        // element types that may be moved as raw bytes
+        static constexpr bool trivially_relocatable = is_trivially_relocatable_v<T>;
+
+        // element types equal exactly when their bytes are
+        static constexpr bool bytewise_comparable = std::is_integral_v<T> || std::is_same_v<T, std::byte>;
+
+        template<typename, std::size_t>
+        friend class static_vector;
+
+        // buffers up to this size are swapped whole instead of by live prefix
+        static constexpr size_type small_buffer_bytes{64};
 
         // methods for obtaining (const) pointer to required object
-        // A (since we use pointer to object B providing storage for A)
-        pointer cleaned_data_ptr(size_t idx = 0) noexcept
+        constexpr pointer cleaned_data_ptr(size_t idx = 0) noexcept
         {
-            pointer p = std::launder(reinterpret_cast<pointer>(buffer));
-            return p + idx;
+            return storage.ptr() + idx;
         }
 
-        const_pointer cleaned_const_data_ptr(size_t idx = 0) const noexcept
+        constexpr const_pointer cleaned_const_data_ptr(size_t idx = 0) const noexcept
         {
-            const_pointer p = std::launder(reinterpret_cast<const_pointer>(buffer));
-            return p + idx;
+            return storage.ptr() + idx;
         }
 
         // methods for validation
-        void validate_index(size_type index) const
+        constexpr void validate_index(size_type index) const
         {
             if (index >= curr_size)
-                throw std::out_of_range("Out of Range.");
+                KSV_THROW(std::out_of_range("Out of Range."), "Out of Range.");
         }
 
-        void validate_curr_size() const
+        constexpr void validate_curr_size() const
         {
             if (curr_size >= N)
-                throw std::length_error("Reached max capacity.");
+                KSV_THROW(std::length_error("Reached max capacity."), "Reached max capacity.");
         }
 
-        void validate_count(size_type count) const
+        constexpr void validate_count(size_type count) const
         {
             if (count > N)
-                throw std::bad_alloc();
+                KSV_THROW(std::bad_alloc(), "Exceeded capacity.");
+        }
+
+        // room for count more elements
+        constexpr void validate_free(size_type count) const
+        {
+            if (count > N - curr_size)
+                KSV_THROW(std::bad_alloc(), "Exceeded capacity.");
+        }
+
+        constexpr size_type index_of(const_iterator pos) const
+        {
+            return static_cast<size_type>(pos - cbegin());
         }
 
         // for clearing
-        void clear_elements()
+        constexpr void clear_elements()
         {
-            pointer cleaned_ptr{cleaned_data_ptr()};
-            for (size_t i{0}; i < curr_size; ++i)
-                std::destroy_at(cleaned_ptr + (curr_size - 1 - i));// reverse order
-            curr_size = 0;
+            truncate(0);
+        }
+
+        // destroys the elements past new_size
+        constexpr void truncate(size_type new_size)
+        {
+            if constexpr (!trivially_copyable)
+            {
+                pointer cleaned_ptr{cleaned_data_ptr()};
+                for (size_t i{curr_size}; i > new_size; --i)
+                    std::destroy_at(cleaned_ptr + (i - 1));// reverse order
+            }
+            curr_size = static_cast<detail::size_for<N>>(new_size);
+        }
+
+        // appends [first, last) in a single pass, without rolling back on failure
+        template<typename Iter, typename Sentinel>
+        constexpr void append_internal(Iter first, Sentinel last)
+        {
+            if constexpr (std::sized_sentinel_for<Sentinel, Iter>)
+                append_counted(first, static_cast<size_type>(last - first));
+            else
+                for (; first != last; ++first)
+                {
+                    validate_free(1);
+                    eb_internal(*first);
+                }
+        }
+
+        // appends count elements starting at first after a single capacity check
+        template<typename Iter>
+        constexpr void append_counted(Iter first, size_type count)
+        {
+            validate_free(count);
+            if constexpr (trivially_copyable && std::contiguous_iterator<Iter> && std::is_same_v<std::iter_value_t<Iter>, T>)
+            {
+                copy_raw(std::to_address(first), count, cleaned_data_ptr(curr_size));
+                curr_size += count;
+            }
+            else
+                for (size_type i{0}; i < count; ++i, ++first)
+                    eb_internal(*first);
+        }
+
+        // assigns over the live prefix, then truncates or appends the rest
+        template<typename Iter, typename Sentinel>
+        constexpr void assign_internal(Iter first, Sentinel last)
+        {
+            if constexpr (std::sized_sentinel_for<Sentinel, Iter>)
+                validate_count(static_cast<size_type>(last - first));
+
+            if constexpr (trivially_copyable)
+                clear_elements();
+            size_type i{0};
+            for (; i < curr_size && first != last; ++i, ++first)
+                *cleaned_data_ptr(i) = *first;
+            truncate(i);
+            append_internal(std::move(first), last);
+        }
+
+        // grows with append, rolling back on failure, or shrinks to count
+        template<typename Append>
+        constexpr void resize_internal(size_type count, Append append)
+        {
+            if (count <= curr_size)
+            {
+                truncate(count);
+                return;
+            }
+
+            validate_count(count);
+            const size_type old_size{curr_size};
+            KSV_TRY
+            {
+                while (curr_size < count)
+                    append();
+            }
+            KSV_CATCH_ALL
+            {
+                truncate(old_size);
+                KSV_RETHROW;
+            }
         }
 
         // internally used modification functions
-        void swap(static_vector &other)
+        constexpr void swap(static_vector &other)
+        {
+            if constexpr (trivially_relocatable)
+            {
+                if constexpr (sizeof(storage) <= small_buffer_bytes && std::is_trivially_copyable_v<detail::storage_for<T, N>>)
+                {
+                    // fixed-size copies of whole buffers compile to a few register
+                    // moves, constant evaluation rejects copying unconstructed elements
+                    if (!std::is_constant_evaluated())
+                    {
+                        std::swap(storage, other.storage);
+                        std::swap(this->curr_size, other.curr_size);
+                        return;
+                    }
+                }
+
+                // only the live prefixes need to be exchanged
+                detail::storage_for<T, N> tmp;
+                copy_raw(cleaned_data_ptr(), curr_size, tmp.ptr());
+                copy_raw(other.cleaned_data_ptr(), other.curr_size, cleaned_data_ptr());
+                copy_raw(tmp.ptr(), curr_size, other.cleaned_data_ptr());
+                std::swap(this->curr_size, other.curr_size);
+                return;
+            }
+
+            // swap the common prefix, then relocate the surplus tail of
+            // the longer vector into the unconstructed storage of the shorter
+            static_vector &longer{curr_size < other.curr_size ? other : *this};
+            static_vector &shorter{curr_size < other.curr_size ? *this : other};
+            const auto common{shorter.curr_size};
+            std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+            while (shorter.curr_size < longer.curr_size)
+                shorter.mb_internal(std::move(*longer.cleaned_data_ptr(shorter.curr_size)));
+            std::destroy(longer.cleaned_data_ptr(common), longer.end());
+            longer.curr_size = common;
+        }
+
+        // bulk copy for trivially copyable T, replaces the current contents
+        constexpr void copy_bytes(const static_vector &other) noexcept
+        {
+            copy_raw(other.cleaned_const_data_ptr(), other.curr_size, cleaned_data_ptr());
+            curr_size = other.curr_size;
+        }
+
+        // bulk move for trivially relocatable T into an empty vector, the
+        // source gives up ownership unless its elements are plain copies
+        template<std::size_t M>
+        constexpr void relocate_from(static_vector<T, M> &other) noexcept
+        {
+            copy_raw(other.cleaned_const_data_ptr(), other.curr_size, cleaned_data_ptr());
+            curr_size = static_cast<detail::size_for<N>>(other.curr_size);
+            if constexpr (!trivially_copyable)
+                other.curr_size = 0;
+        }
+
+        // constant evaluation constructs the copies, which the destination
+        // may not hold yet, everything else is copied as bytes
+        static constexpr void copy_raw(const_pointer src, size_type count, pointer dst) noexcept
         {
-            std::swap_ranges(begin(), end(), other.begin());
-            std::swap(this->curr_size, other.curr_size);
+            // an empty source range may come with a null pointer, which memcpy rejects
+            if (count == 0)
+                return;
+            if constexpr (trivially_copyable)
+                if (std::is_constant_evaluated())
+                {
+                    for (size_type i{0}; i < count; ++i)
+                        std::construct_at(dst + i, src[i]);
+                    return;
+                }
+            std::memcpy(static_cast<void *>(dst), src, count * sizeof(T));
         }
 
-        void pb_internal(const_reference value)
+        // like copy_raw, for overlapping ranges
+        static constexpr void move_raw(pointer src, size_type count, pointer dst) noexcept
         {
-            ::new (buffer + curr_size * sizeof(T)) T(value);
+            if (count == 0)
+                return;
+            if constexpr (trivially_copyable)
+                if (std::is_constant_evaluated())
+                {
+                    if (dst < src)
+                        for (size_type i{0}; i < count; ++i)
+                            std::construct_at(dst + i, src[i]);
+                    else
+                        for (size_type i{count}; i > 0; --i)
+                            std::construct_at(dst + (i - 1), src[i - 1]);
+                    return;
+                }
+            std::memmove(static_cast<void *>(dst), src, count * sizeof(T));
+        }
+
+        // relocates the tail to open a gap of count elements at idx and fills
+        // it with fill(pointer), closing the gap again if filling throws
+        template<typename Fill>
+        constexpr void insert_relocating(size_type idx, size_type count, Fill fill)
+        {
+            move_raw(cleaned_data_ptr(idx), curr_size - idx, cleaned_data_ptr(idx + count));
+            size_type filled{0};
+            KSV_TRY
+            {
+                for (; filled < count; ++filled)
+                    fill(cleaned_data_ptr(idx + filled));
+            }
+            KSV_CATCH_ALL
+            {
+                std::destroy(cleaned_data_ptr(idx), cleaned_data_ptr(idx + filled));
+                move_raw(cleaned_data_ptr(idx + count), curr_size - idx, cleaned_data_ptr(idx));
+                KSV_RETHROW;
+            }
+            curr_size += count;
+        }
+
+        constexpr void pb_internal(const_reference value)
+        {
+            std::construct_at(cleaned_data_ptr(curr_size), value);
             ++curr_size;
         }
 
-        void mb_internal(value_type &&value)
+        constexpr void mb_internal(value_type &&value)
         {
-            ::new (buffer + curr_size * sizeof(T)) T(std::move(value));
+            std::construct_at(cleaned_data_ptr(curr_size), std::move(value));
             ++curr_size;
         }
 
         template<typename... Args>
-        void eb_internal(Args &&...args)
+        constexpr void eb_internal(Args &&...args)
         {
-            ::new (buffer + curr_size * sizeof(T)) T(std::forward<Args>(args)...);
+            std::construct_at(cleaned_data_ptr(curr_size), std::forward<Args>(args)...);
             ++curr_size;
         }
     };
 
+    template<typename T, std::size_t N>
+    struct is_trivially_relocatable<static_vector<T, N>> : is_trivially_relocatable<T>
+    {
+    };
+
     // deduction guides
     template<typename T, typename... U>
     static_vector(T, U...) -> static_vector<std::enable_if_t<(std::is_same_v<T, U> && ...), T>, 1 + sizeof...(U)>;
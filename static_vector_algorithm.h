@@ -0,0 +1,376 @@
+#pragma once
+
+#include "simd_detail.h"
+#include "static_vector.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace ksv
+{
+
+    namespace detail
+    {
+        // element types the searches take, equality matches operator==
+        template<typename T>
+        concept searchable_element = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+        // those compared in vector lanes, integers of up to 8 bytes, float
+        // and double; the others, such as long double, are scanned one by one
+        template<typename T>
+        concept simd_element = searchable_element<T> && (std::is_integral_v<T> ? sizeof(T) <= 8 : std::is_same_v<T, float> || std::is_same_v<T, double>);
+
+        // lanes of a block starting count elements before the end of the
+        // valid range, as a mask of one bit per byte
+        template<typename T>
+        constexpr unsigned valid_bytes(std::size_t count) noexcept
+        {
+            return count * sizeof(T) >= 32 ? ~0u : (1u << (count * sizeof(T))) - 1;
+        }
+
+        template<typename T, std::size_t M>
+        constexpr bool equals_any(const T &elem, const std::array<T, M> &needles) noexcept
+        {
+            bool hit{false};
+            for (const T &needle : needles)
+                hit |= elem == needle;
+            return hit;
+        }
+
+        // index of the first element equal to a needle, or size; the number
+        // of such elements for Count
+        template<bool Count, typename T, std::size_t M>
+        constexpr std::size_t scan_scalar(const T *data, std::size_t size, const std::array<T, M> &needles) noexcept
+        {
+            std::size_t found{0};
+            for (std::size_t i{0}; i < size; ++i)
+            {
+                if constexpr (Count)
+                    found += equals_any(data[i], needles);
+                else if (equals_any(data[i], needles))
+                    return i;
+            }
+            return Count ? found : size;
+        }
+
+#if defined(KSV_X86_DISPATCH)
+        // one bit per byte of every lane of block equal to needle
+        template<typename T>
+        inline unsigned equal_bytes_sse2(__m128i block, __m128i needle) noexcept
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return static_cast<unsigned>(_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)))));
+            else if constexpr (std::is_same_v<T, double>)
+                return static_cast<unsigned>(_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)))));
+            else if constexpr (sizeof(T) == 1)
+                return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+            else if constexpr (sizeof(T) == 2)
+                return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(block, needle)));
+            else if constexpr (sizeof(T) == 4)
+                return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(block, needle)));
+            else
+            {
+                // SSE2 has no 64-bit compare, both 32-bit halves have to match
+                const __m128i halves{_mm_cmpeq_epi32(block, needle)};
+                return static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)))));
+            }
+        }
+
+        template<typename T>
+        inline __m128i broadcast_sse2(T value) noexcept
+        {
+            __m128i block;
+            if constexpr (sizeof(T) == 1)
+                block = _mm_set1_epi8(std::bit_cast<char>(value));
+            else if constexpr (sizeof(T) == 2)
+                block = _mm_set1_epi16(std::bit_cast<short>(value));
+            else if constexpr (sizeof(T) == 4)
+                block = _mm_set1_epi32(std::bit_cast<int>(value));
+            else
+                block = _mm_set1_epi64x(std::bit_cast<long long>(value));
+            return block;
+        }
+
+        template<typename T>
+        KSV_TARGET_AVX2 inline unsigned equal_bytes_avx2(__m256i block, __m256i needle) noexcept
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block), _mm256_castsi256_ps(needle), _CMP_EQ_OQ))));
+            else if constexpr (std::is_same_v<T, double>)
+                return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block), _mm256_castsi256_pd(needle), _CMP_EQ_OQ))));
+            else if constexpr (sizeof(T) == 1)
+                return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+            else if constexpr (sizeof(T) == 2)
+                return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(block, needle)));
+            else if constexpr (sizeof(T) == 4)
+                return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(block, needle)));
+            else
+                return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(block, needle)));
+        }
+
+        template<typename T>
+        KSV_TARGET_AVX2 inline __m256i broadcast_avx2(T value) noexcept
+        {
+            __m256i block;
+            if constexpr (sizeof(T) == 1)
+                block = _mm256_set1_epi8(std::bit_cast<char>(value));
+            else if constexpr (sizeof(T) == 2)
+                block = _mm256_set1_epi16(std::bit_cast<short>(value));
+            else if constexpr (sizeof(T) == 4)
+                block = _mm256_set1_epi32(std::bit_cast<int>(value));
+            else
+                block = _mm256_set1_epi64x(std::bit_cast<long long>(value));
+            return block;
+        }
+
+        // the capacity is a compile-time constant, so whole blocks are read as
+        // long as they stay inside the buffer and lanes past size are masked
+        // off; only the part of the buffer after the last whole block is
+        // scanned element by element
+        template<bool Count, std::size_t Capacity, typename T, std::size_t M>
+        inline std::size_t scan_sse2(const T *data, std::size_t size, const std::array<T, M> &needles) noexcept
+        {
+            constexpr std::size_t lanes{16 / sizeof(T)};
+            __m128i wanted[M];
+            for (std::size_t m{0}; m < M; ++m)
+                wanted[m] = broadcast_sse2(needles[m]);
+
+            std::size_t found{0};
+            std::size_t i{0};
+            for (; i < size && i + lanes <= Capacity; i += lanes)
+            {
+                const __m128i block{_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i))};
+                unsigned mask{0};
+                for (std::size_t m{0}; m < M; ++m)
+                    mask |= equal_bytes_sse2<T>(block, wanted[m]);
+                mask &= valid_bytes<T>(size - i);
+                if constexpr (Count)
+                    found += static_cast<std::size_t>(std::popcount(mask)) / sizeof(T);
+                else if (mask != 0)
+                    return i + static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(T);
+            }
+            if (i >= size)
+                return Count ? found : size;
+            const std::size_t rest{scan_scalar<Count>(data + i, size - i, needles)};
+            return Count ? found + rest : i + rest;
+        }
+
+        template<bool Count, std::size_t Capacity, typename T, std::size_t M>
+        KSV_TARGET_AVX2 inline std::size_t scan_avx2(const T *data, std::size_t size, const std::array<T, M> &needles) noexcept
+        {
+            constexpr std::size_t lanes{32 / sizeof(T)};
+            __m256i wanted[M];
+            for (std::size_t m{0}; m < M; ++m)
+                wanted[m] = broadcast_avx2(needles[m]);
+
+            std::size_t found{0};
+            std::size_t i{0};
+            for (; i < size && i + lanes <= Capacity; i += lanes)
+            {
+                const __m256i block{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i))};
+                unsigned mask{0};
+                for (std::size_t m{0}; m < M; ++m)
+                    mask |= equal_bytes_avx2<T>(block, wanted[m]);
+                mask &= valid_bytes<T>(size - i);
+                if constexpr (Count)
+                    found += static_cast<std::size_t>(std::popcount(mask)) / sizeof(T);
+                else if (mask != 0)
+                    return i + static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(T);
+            }
+            if (i >= size)
+                return Count ? found : size;
+            const std::size_t rest{scan_sse2<Count, Capacity - lanes * (Capacity / lanes)>(data + i, size - i, needles)};
+            return Count ? found + rest : i + rest;
+        }
+#endif
+
+        // picks the widest instruction set the running CPU supports
+        template<bool Count, std::size_t Capacity, typename T, std::size_t M>
+        constexpr std::size_t scan(const T *data, std::size_t size, const std::array<T, M> &needles) noexcept
+        {
+#if defined(KSV_X86_DISPATCH)
+            if constexpr (simd_element<T>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    if constexpr (Capacity * sizeof(T) >= 32)
+                    {
+#if defined(__AVX2__)
+                        return scan_avx2<Count, Capacity>(data, size, needles);
+#else
+                        if (__builtin_cpu_supports("avx2"))
+                            return scan_avx2<Count, Capacity>(data, size, needles);
+#endif
+                    }
+                    return scan_sse2<Count, Capacity>(data, size, needles);
+                }
+            }
+#endif
+            return scan_scalar<Count>(data, size, needles);
+        }
+    }// namespace detail
+
+    // vectorized searches for static_vectors of arithmetic types, with the
+    // same results as std::find and std::count
+    template<detail::searchable_element T, std::size_t N>
+    constexpr typename static_vector<T, N>::iterator find(static_vector<T, N> &vec, const T &value) noexcept
+    {
+        return vec.begin() + detail::scan<false, N>(vec.data(), vec.size(), std::array<T, 1>{value});
+    }
+
+    template<detail::searchable_element T, std::size_t N>
+    constexpr typename static_vector<T, N>::const_iterator find(const static_vector<T, N> &vec, const T &value) noexcept
+    {
+        return vec.begin() + detail::scan<false, N>(vec.data(), vec.size(), std::array<T, 1>{value});
+    }
+
+    template<detail::searchable_element T, std::size_t N>
+    constexpr bool contains(const static_vector<T, N> &vec, const T &value) noexcept
+    {
+        return detail::scan<false, N>(vec.data(), vec.size(), std::array<T, 1>{value}) != vec.size();
+    }
+
+    template<detail::searchable_element T, std::size_t N>
+    constexpr std::size_t count(const static_vector<T, N> &vec, const T &value) noexcept
+    {
+        return detail::scan<true, N>(vec.data(), vec.size(), std::array<T, 1>{value});
+    }
+
+    // first element equal to any of values, each compared in the same pass
+    template<detail::searchable_element T, std::size_t N, std::convertible_to<T>... Values>
+        requires(sizeof...(Values) > 0)
+    constexpr typename static_vector<T, N>::iterator find_if_eq_any(static_vector<T, N> &vec, const Values &...values) noexcept
+    {
+        return vec.begin() + detail::scan<false, N>(vec.data(), vec.size(), std::array<T, sizeof...(Values)>{static_cast<T>(values)...});
+    }
+
+    template<detail::searchable_element T, std::size_t N, std::convertible_to<T>... Values>
+        requires(sizeof...(Values) > 0)
+    constexpr typename static_vector<T, N>::const_iterator find_if_eq_any(const static_vector<T, N> &vec, const Values &...values) noexcept
+    {
+        return vec.begin() + detail::scan<false, N>(vec.data(), vec.size(), std::array<T, sizeof...(Values)>{static_cast<T>(values)...});
+    }
+
+
+    namespace detail
+    {
+        // largest size sorted with a network, longer vectors go to std::sort
+        inline constexpr std::size_t max_network_size{32};
+
+        struct comparator
+        {
+            std::uint8_t lo;
+            std::uint8_t hi;
+        };
+
+        // Batcher's odd-even merge sort network for a power-of-two size,
+        // returns the number of comparators and stores them when out is set
+        constexpr std::size_t batcher_network(std::size_t size, comparator *out)
+        {
+            std::size_t count{0};
+            for (std::size_t p{1}; p < size; p *= 2)
+                for (std::size_t k{p}; k >= 1; k /= 2)
+                    for (std::size_t j{k % p}; j + k < size; j += 2 * k)
+                        for (std::size_t i{0}; i < k && i + j + k < size; ++i)
+                            if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                            {
+                                if (out)
+                                    out[count] = {static_cast<std::uint8_t>(i + j), static_cast<std::uint8_t>(i + j + k)};
+                                ++count;
+                            }
+            return count;
+        }
+
+        template<std::size_t Size>
+        inline constexpr auto sorting_network{[] {
+            std::array<comparator, batcher_network(Size, nullptr)> network{};
+            batcher_network(Size, network.data());
+            return network;
+        }()};
+
+        // element types ordered by plain < whose compare-exchange compiles to
+        // min and max instructions, which the compiler can also pack into
+        // vector min and max across independent comparators
+        template<typename T, typename Compare>
+        concept min_max_sortable = simd_element<T> && (std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>);
+
+        template<typename T, typename Compare>
+        constexpr void compare_exchange(T &lo, T &hi, Compare &comp)
+        {
+            if constexpr (min_max_sortable<T, Compare>)
+            {
+                const T a{lo};
+                const T b{hi};
+                lo = b < a ? b : a;
+                hi = b < a ? a : b;
+            }
+            else if (comp(hi, lo))
+                std::ranges::swap(lo, hi);
+        }
+
+        // sorts size <= Bucket elements with the network for Bucket, or the
+        // one for Bucket / 2 when that suffices
+        template<std::size_t Bucket, typename T, typename Compare>
+        constexpr void sort_network(T *data, std::size_t size, Compare &comp)
+        {
+            if constexpr (Bucket > 2)
+                if (size <= Bucket / 2)
+                    return sort_network<Bucket / 2>(data, size, comp);
+
+            constexpr auto &network{sorting_network<Bucket>};
+            if constexpr (min_max_sortable<T, Compare>)
+            {
+                // padding with the largest value makes the network branch free;
+                // the fixed trip counts and selects let the elements stay in
+                // registers, where copies of size elements went through memory
+                constexpr T sentinel{std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max()};
+                T padded[Bucket];
+                for (std::size_t i{0}; i < Bucket; ++i)
+                {
+                    const T elem{data[i < size ? i : 0]};
+                    padded[i] = i < size ? elem : sentinel;
+                }
+                [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    (compare_exchange(padded[network[Is].lo], padded[network[Is].hi], comp), ...);
+                }(std::make_index_sequence<network.size()>{});
+                for (std::size_t i{0}; i < Bucket; ++i)
+                    if (i < size)
+                        data[i] = padded[i];
+            }
+            else
+            {
+                // as if padded with elements greater than all others: those
+                // never leave the back, so comparators reaching past size
+                // would not move anything and are skipped
+                [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    ((network[Is].hi < size ? compare_exchange(data[network[Is].lo], data[network[Is].hi], comp) : void()), ...);
+                }(std::make_index_sequence<network.size()>{});
+            }
+        }
+    }// namespace detail
+
+    // sorts with a sorting network fixed at compile time for vectors of up
+    // to 32 elements, and with std::sort beyond; not stable
+    template<typename T, std::size_t N, typename Compare = std::less<>>
+    constexpr void sort(static_vector<T, N> &vec, Compare comp = {})
+    {
+        const std::size_t size{vec.size()};
+        if (size <= 1)
+            return;
+        if (size > detail::max_network_size)
+        {
+            std::sort(vec.begin(), vec.end(), comp);
+            return;
+        }
+        detail::sort_network<std::clamp<std::size_t>(std::bit_ceil(N), 2, detail::max_network_size)>(vec.data(), size, comp);
+    }
+
+}// namespace ksv
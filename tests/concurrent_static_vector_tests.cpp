@@ -0,0 +1,156 @@
+// Runtime checks of concurrent_static_vector against std::vector, and between real writer and reader threads.
+
+#include "concurrent_static_vector.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    std::string make_value(int v)
+    {
+        return std::string(static_cast<std::size_t>(v % 40), static_cast<char>('a' + v % 26));
+    }
+
+    // reserved slots filled out of order only become visible once the gap before them is filled
+    void single_thread()
+    {
+        constexpr std::size_t capacity{64};
+        ksv::concurrent_static_vector<std::string, capacity> actual;
+        std::vector<std::string> expected;
+
+        for (int step{0}; step < 5000; ++step)
+        {
+            const std::size_t room{capacity - expected.size()};
+            switch (kds_test::random(0, 4))
+            {
+                case 0:
+                    if (room > 0)
+                    {
+                        actual.push_back(make_value(step));
+                        expected.push_back(make_value(step));
+                    }
+                    break;
+                case 1:
+                    if (room > 0)
+                    {
+                        KDS_CHECK(*actual.try_emplace_back(make_value(step)) == make_value(step));
+                        expected.push_back(make_value(step));
+                    }
+                    break;
+                case 2:
+                {
+                    if (room == 0)
+                        break;// failed appends may have claimed past the end
+                    const auto count{kds_test::random<std::size_t>(0, std::min<std::size_t>(room, 8))};
+                    const std::size_t first{actual.reserve_n(count)};
+                    KDS_CHECK(first == expected.size());
+                    std::vector<std::size_t> order(count);
+                    for (std::size_t i{0}; i < count; ++i)
+                        order[i] = i;
+                    std::ranges::shuffle(order, kds_test::rng());
+                    std::vector<bool> filled(count);
+                    for (const std::size_t i : order)
+                    {
+                        actual.emplace_at(first + i, make_value(step + static_cast<int>(i)));
+                        filled[i] = true;
+                        const auto prefix{static_cast<std::size_t>(std::ranges::find(filled, false) - filled.begin())};
+                        KDS_CHECK(actual.size() == expected.size() + prefix);
+                    }
+                    for (std::size_t i{0}; i < count; ++i)
+                        expected.push_back(make_value(step + static_cast<int>(i)));
+                    break;
+                }
+                case 3:
+                    if (room == 0)
+                    {
+                        KDS_CHECK(actual.try_emplace_back("full") == nullptr);
+                        KDS_CHECK_THROWS(std::bad_alloc, actual.push_back("full"));
+                        KDS_CHECK_THROWS(std::bad_alloc, actual.reserve_n(1));
+                    }
+                    break;
+                case 4:
+                    if (kds_test::random(0, 20) == 0)
+                    {
+                        actual.clear();
+                        expected.clear();
+                    }
+                    break;
+            }
+            KDS_CHECK(std::ranges::equal(actual, expected));
+        }
+    }
+
+    // readers only ever see fully constructed elements, and each writer's
+    // elements stay in the order it appended them
+    void writers_and_reader()
+    {
+        constexpr int writers{4};
+        constexpr int per_writer{5000};
+        static ksv::concurrent_static_vector<std::string, writers * per_writer> vector;
+        std::atomic<bool> done{false};
+
+        std::thread reader{[&done] {
+            while (!done.load())
+            {
+                const std::size_t size{vector.size()};
+                for (std::size_t i{0}; i < size; ++i)
+                {
+                    const std::string &value{vector[i]};
+                    KDS_CHECK(value.size() >= 2 && value.front() == value.back());
+                }
+                std::this_thread::yield();
+            }
+        }};
+
+        std::vector<std::thread> threads;
+        for (int w{0}; w < writers; ++w)
+            threads.emplace_back([w] {
+                for (int i{0}; i < per_writer;)
+                {
+                    // the tag at both ends lets the reader spot torn elements
+                    const auto tagged = [w](int n) {
+                        const char tag{static_cast<char>('a' + w)};
+                        return tag + std::to_string(n).append(24, '.') + tag;
+                    };
+                    if (i % 5 == 0 && i + 5 <= per_writer)
+                    {
+                        const std::size_t first{vector.reserve_n(5)};
+                        for (int k{4}; k >= 0; --k)
+                            vector.emplace_at(first + static_cast<std::size_t>(k), tagged(i + k));
+                        i += 5;
+                    }
+                    else
+                        vector.emplace_back(tagged(i++));
+                }
+            });
+        for (std::thread &thread : threads)
+            thread.join();
+        done.store(true);
+        reader.join();
+
+        KDS_CHECK(vector.size() == vector.capacity());
+        std::vector<int> next(writers, 0);
+        for (const std::string &value : vector)
+        {
+            int &expected{next[static_cast<std::size_t>(value.front() - 'a')]};
+            KDS_CHECK(std::stoi(value.substr(1)) == expected++);
+        }
+        for (const int count : next)
+            KDS_CHECK(count == per_writer);
+    }
+
+}// namespace
+
+int main()
+{
+    single_thread();
+    writers_and_reader();
+}
@@ -0,0 +1,139 @@
+// Runtime checks of mpmc_queue against std::deque, and between real producer and consumer threads.
+
+#include "mpmc_queue.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    // one thread playing every role, the blocking calls only where they cannot block
+    template<std::size_t N>
+    void single_thread()
+    {
+        ksv::mpmc_queue<std::string, N> queue;
+        std::deque<std::string> expected;
+
+        for (int step{0}; step < 20000; ++step)
+        {
+            const std::string value(static_cast<std::size_t>(step % 40), static_cast<char>('a' + step % 26));
+            switch (kds_test::random(0, 3))
+            {
+                case 0:
+                {
+                    const bool pushed{queue.try_push(value)};
+                    KDS_CHECK(pushed == (expected.size() < N));
+                    if (pushed)
+                        expected.push_back(value);
+                    break;
+                }
+                case 1:
+                    if (expected.size() < N)
+                    {
+                        queue.push(value);
+                        expected.push_back(value);
+                    }
+                    break;
+                case 2:
+                {
+                    std::string out;
+                    const bool popped{queue.try_pop(out)};
+                    KDS_CHECK(popped == !expected.empty());
+                    if (popped)
+                    {
+                        KDS_CHECK(out == expected.front());
+                        expected.pop_front();
+                    }
+                    break;
+                }
+                case 3:
+                    if (!expected.empty())
+                    {
+                        std::string out;
+                        queue.pop(out);
+                        KDS_CHECK(out == expected.front());
+                        expected.pop_front();
+                    }
+                    break;
+            }
+            KDS_CHECK(queue.size() == expected.size());
+            KDS_CHECK(queue.empty() == expected.empty());
+        }
+    }
+
+    // every pushed element is popped exactly once, and each consumer sees the
+    // elements of any one producer in the order they were pushed
+    template<std::size_t N>
+    void producers_consumers(int producers, int consumers)
+    {
+        constexpr int per_producer{20000};
+        static ksv::mpmc_queue<long, N> queue;
+        const int total{producers * per_producer};
+        std::vector<std::vector<long>> received(static_cast<std::size_t>(consumers));
+
+        std::vector<std::thread> threads;
+        for (int p{0}; p < producers; ++p)
+            threads.emplace_back([p] {
+                for (int i{0}; i < per_producer; ++i)
+                {
+                    const long value{static_cast<long>(p) * per_producer + i};
+                    if (i % 2 == 0)
+                        queue.push(value);
+                    else
+                        while (!queue.try_push(value))
+                            std::this_thread::yield();
+                }
+            });
+        for (int c{0}; c < consumers; ++c)
+            threads.emplace_back([c, consumers, total, &received] {
+                std::vector<long> &out{received[static_cast<std::size_t>(c)]};
+                const int share{total / consumers + (c < total % consumers ? 1 : 0)};
+                for (int i{0}; i < share; ++i)
+                {
+                    long value{};
+                    if (i % 2 == 0)
+                        queue.pop(value);
+                    else
+                        while (!queue.try_pop(value))
+                            std::this_thread::yield();
+                    out.push_back(value);
+                }
+            });
+        for (std::thread &thread : threads)
+            thread.join();
+        KDS_CHECK(queue.empty());
+
+        std::vector<long> all;
+        for (const std::vector<long> &out : received)
+        {
+            std::vector<long> last(static_cast<std::size_t>(producers), -1);
+            for (const long value : out)
+            {
+                long &previous{last[static_cast<std::size_t>(value / per_producer)]};
+                KDS_CHECK(value > previous);
+                previous = value;
+            }
+            all.insert(all.end(), out.begin(), out.end());
+        }
+        std::ranges::sort(all);
+        KDS_CHECK(all.size() == static_cast<std::size_t>(total));
+        for (int i{0}; i < total; ++i)
+            KDS_CHECK(all[static_cast<std::size_t>(i)] == i);
+    }
+
+}// namespace
+
+int main()
+{
+    single_thread<8>();
+    single_thread<5>();
+    producers_consumers<16>(4, 4);
+    producers_consumers<7>(2, 3);
+    producers_consumers<1024>(3, 1);
+}
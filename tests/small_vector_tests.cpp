@@ -0,0 +1,204 @@
+// Runtime checks of small_vector against std::vector on randomized operations.
+
+#include "small_vector.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+    template<typename T>
+    T make_value(int v)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::string(static_cast<std::size_t>(v % 40), static_cast<char>('a' + v % 26));
+        else
+            return static_cast<T>(v);
+    }
+
+    // allocator counting its allocations, to check the growth policy
+    template<typename T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        static inline int allocations{0};
+
+        counting_allocator() = default;
+
+        template<typename U>
+        counting_allocator(const counting_allocator<U> &) noexcept
+        {
+        }
+
+        T *allocate(std::size_t count)
+        {
+            ++allocations;
+            return std::allocator<T>{}.allocate(count);
+        }
+
+        void deallocate(T *p, std::size_t count) noexcept { std::allocator<T>{}.deallocate(p, count); }
+
+        friend bool operator==(const counting_allocator &, const counting_allocator &) = default;
+    };
+
+    // operations crossing between the inline buffer and the heap in both directions
+    template<typename T>
+    void random_operations()
+    {
+        constexpr std::size_t inline_capacity{8};
+        ksv::small_vector<T, inline_capacity> actual;
+        std::vector<T> expected;
+
+        for (int step{0}; step < 20000; ++step)
+        {
+            const std::size_t size{expected.size()};
+            const auto pos{kds_test::random<std::size_t>(0, size)};
+            const T value{make_value<T>(step)};
+
+            switch (kds_test::random(0, 10))
+            {
+                case 0:
+                case 1:
+                    actual.push_back(value);
+                    expected.push_back(value);
+                    break;
+                case 2:
+                    KDS_CHECK(*actual.insert(actual.begin() + pos, value) == value);
+                    expected.insert(expected.begin() + pos, value);
+                    break;
+                case 3:
+                {
+                    std::vector<T> source(kds_test::random<std::size_t>(0, 12), value);
+                    actual.insert(actual.begin() + pos, source.begin(), source.end());
+                    expected.insert(expected.begin() + pos, source.begin(), source.end());
+                    break;
+                }
+                case 4:
+                    if (pos < size)
+                    {
+                        actual.erase(actual.begin() + pos);
+                        expected.erase(expected.begin() + pos);
+                    }
+                    break;
+                case 5:
+                {
+                    const auto last{kds_test::random<std::size_t>(pos, size)};
+                    actual.erase(actual.begin() + pos, actual.begin() + last);
+                    expected.erase(expected.begin() + pos, expected.begin() + last);
+                    break;
+                }
+                case 6:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, 3 * inline_capacity)};
+                    actual.resize(count, value);
+                    expected.resize(count, value);
+                    break;
+                }
+                case 7:
+                    actual.shrink_to_fit();
+                    KDS_CHECK(actual.is_inline() == (size <= inline_capacity));
+                    break;
+                case 8:
+                    actual.reserve(kds_test::random<std::size_t>(0, 4 * inline_capacity));
+                    break;
+                case 9:
+                {
+                    ksv::small_vector<T, inline_capacity> copy{actual};
+                    KDS_CHECK(copy == actual);
+                    ksv::small_vector<T, inline_capacity> moved{std::move(actual)};
+                    actual = copy;
+                    KDS_CHECK(moved == actual);
+                    swap(moved, copy);
+                    KDS_CHECK(moved == copy);
+                    break;
+                }
+                case 10:
+                    if (size > 0)
+                    {
+                        actual.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+            }
+            KDS_CHECK(std::ranges::equal(actual, expected));
+            KDS_CHECK(actual.capacity() >= actual.size());
+        }
+    }
+
+    // appending one element at a time reallocates a logarithmic number of times,
+    // whichever of the appending operations is used
+    void geometric_growth()
+    {
+        using vector = ksv::small_vector<int, 4, counting_allocator<int>>;
+        const int one[1]{1};
+        const auto count_allocations = [](auto append) {
+            vector v;
+            counting_allocator<int>::allocations = 0;
+            for (int i{0}; i < 1000; ++i)
+                append(v);
+            KDS_CHECK(v.size() == 1000);
+            return counting_allocator<int>::allocations;
+        };
+
+        KDS_CHECK(count_allocations([](vector &v) { v.push_back(1); }) <= 12);
+        KDS_CHECK(count_allocations([&one](vector &v) { v.append_range(one); }) <= 12);
+        KDS_CHECK(count_allocations([&one](vector &v) { v.insert(v.end(), one, one + 1); }) <= 12);
+        KDS_CHECK(count_allocations([](vector &v) { v.resize(v.size() + 1); }) <= 12);
+    }
+
+    // a copy throwing while the elements move to the heap keeps the old contents
+    void exception_rollback()
+    {
+        using kds_test::tracked;
+        {
+            ksv::small_vector<tracked, 4> v{1, 2, 3, 4};
+            const std::vector<tracked> source{5, 6, 7, 8, 9};
+
+            tracked::copies_until_throw = 3;
+            KDS_CHECK_THROWS(std::runtime_error, v.append_range(source));
+            KDS_CHECK(std::ranges::equal(v, std::vector<tracked>{1, 2, 3, 4}));
+
+            tracked::copies_until_throw = 0;
+            KDS_CHECK_THROWS(std::runtime_error, v.push_back(source[0]));
+            KDS_CHECK(std::ranges::equal(v, std::vector<tracked>{1, 2, 3, 4}));
+
+            tracked::copies_until_throw = 2;
+            KDS_CHECK_THROWS(std::runtime_error, v.resize(9, source[0]));
+            KDS_CHECK(std::ranges::equal(v, std::vector<tracked>{1, 2, 3, 4}));
+        }
+        KDS_CHECK(tracked::live == 0);
+    }
+
+    void comparisons()
+    {
+        for (int round{0}; round < 2000; ++round)
+        {
+            std::vector<int> lhs(kds_test::random<std::size_t>(0, 12));
+            std::vector<int> rhs(kds_test::random<std::size_t>(0, 12));
+            for (int &value : lhs)
+                value = kds_test::random(0, 2);
+            for (int &value : rhs)
+                value = kds_test::random(0, 2);
+            const ksv::small_vector<int, 6> actual_lhs(lhs.begin(), lhs.end());
+            const ksv::small_vector<int, 6> actual_rhs(rhs.begin(), rhs.end());
+            KDS_CHECK((actual_lhs == actual_rhs) == (lhs == rhs));
+            KDS_CHECK((actual_lhs <=> actual_rhs) == (lhs <=> rhs));
+        }
+    }
+
+}// namespace
+
+int main()
+{
+    random_operations<int>();
+    random_operations<std::string>();
+    geometric_growth();
+    exception_rollback();
+    comparisons();
+}
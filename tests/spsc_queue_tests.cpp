@@ -0,0 +1,151 @@
+// Runtime checks of spsc_queue against std::deque, and between a real producer and consumer thread.
+
+#include "spsc_queue.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    template<typename T>
+    T make_value(int v)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::string(static_cast<std::size_t>(v % 40), static_cast<char>('a' + v % 26));
+        else
+            return static_cast<T>(v);
+    }
+
+    // one thread playing both sides, the bulk operations wrap around the
+    // end of the buffer and stop at capacity or when the queue runs dry
+    template<typename T, std::size_t N>
+    void single_thread()
+    {
+        ksv::spsc_queue<T, N> queue;
+        std::deque<T> expected;
+        int next{0};
+
+        for (int step{0}; step < 20000; ++step)
+        {
+            switch (kds_test::random(0, 4))
+            {
+                case 0:
+                {
+                    const bool pushed{queue.try_push(make_value<T>(next))};
+                    KDS_CHECK(pushed == (expected.size() < N));
+                    if (pushed)
+                        expected.push_back(make_value<T>(next++));
+                    break;
+                }
+                case 1:
+                {
+                    std::vector<T> batch;
+                    for (int i{0}, count{kds_test::random(0, static_cast<int>(N) + 2)}; i < count; ++i)
+                        batch.push_back(make_value<T>(next + i));
+                    const std::size_t pushed{queue.push_n(batch.begin(), batch.size())};
+                    KDS_CHECK(pushed == std::min(batch.size(), N - expected.size()));
+                    expected.insert(expected.end(), batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(pushed));
+                    next += static_cast<int>(pushed);
+                    break;
+                }
+                case 2:
+                {
+                    T out{};
+                    const bool popped{queue.try_pop(out)};
+                    KDS_CHECK(popped == !expected.empty());
+                    if (popped)
+                    {
+                        KDS_CHECK(out == expected.front());
+                        expected.pop_front();
+                    }
+                    break;
+                }
+                case 3:
+                {
+                    std::vector<T> out(static_cast<std::size_t>(kds_test::random(0, static_cast<int>(N) + 2)));
+                    const std::size_t popped{queue.pop_n(out.begin(), out.size())};
+                    KDS_CHECK(popped == std::min(out.size(), expected.size()));
+                    for (std::size_t i{0}; i < popped; ++i)
+                    {
+                        KDS_CHECK(out[i] == expected.front());
+                        expected.pop_front();
+                    }
+                    break;
+                }
+                case 4:
+                    if (T *front{queue.front()})
+                    {
+                        KDS_CHECK(*front == expected.front());
+                        queue.pop();
+                        expected.pop_front();
+                    }
+                    else
+                        KDS_CHECK(expected.empty());
+                    break;
+            }
+            KDS_CHECK(queue.size() == expected.size());
+        }
+    }
+
+    // the consumer sees every element exactly once and in push order
+    template<typename T, std::size_t N>
+    void producer_consumer()
+    {
+        static constexpr int count{200000};
+        static ksv::spsc_queue<T, N> queue;
+
+        std::thread producer{[] {
+            std::vector<T> batch;
+            for (int next{0}; next < count;)
+            {
+                std::size_t pushed{0};
+                if (next % 3 == 0)
+                {
+                    batch.clear();
+                    for (int i{next}; i < std::min(next + 7, count); ++i)
+                        batch.push_back(make_value<T>(i));
+                    pushed = queue.push_n(batch.begin(), batch.size());
+                }
+                else if (queue.try_push(make_value<T>(next)))
+                    pushed = 1;
+                next += static_cast<int>(pushed);
+                if (pushed == 0)
+                    std::this_thread::yield();
+            }
+        }};
+
+        std::vector<T> out(5);
+        for (int expected{0}; expected < count;)
+        {
+            std::size_t popped{0};
+            if (expected % 2 == 0)
+                popped = queue.pop_n(out.begin(), out.size());
+            else if (queue.try_pop(out[0]))
+                popped = 1;
+            for (std::size_t i{0}; i < popped; ++i)
+                KDS_CHECK(out[i] == make_value<T>(expected++));
+            if (popped == 0)
+                std::this_thread::yield();
+        }
+        producer.join();
+        KDS_CHECK(queue.empty());
+    }
+
+}// namespace
+
+int main()
+{
+    single_thread<int, 8>();
+    single_thread<int, 7>();
+    single_thread<std::string, 8>();
+    single_thread<std::string, 5>();
+    producer_consumer<int, 64>();
+    producer_consumer<int, 5>();
+    producer_consumer<std::string, 16>();
+}
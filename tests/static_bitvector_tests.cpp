@@ -0,0 +1,212 @@
+// Runtime checks of static_bitvector against std::vector<bool> on randomized operations.
+
+#include "static_bitvector.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+    template<std::size_t N>
+    bool same(const ksv::static_bitvector<N> &actual, const std::vector<bool> &expected)
+    {
+        return actual.size() == expected.size() && std::ranges::equal(actual, expected);
+    }
+
+    // counting and searching work on whole words, so the bits past size()
+    // in the last word must have stayed zero
+    template<std::size_t N>
+    void check_queries(const ksv::static_bitvector<N> &actual, const std::vector<bool> &expected)
+    {
+        const auto set{static_cast<std::size_t>(std::ranges::count(expected, true))};
+        KDS_CHECK(actual.count() == set);
+        KDS_CHECK(actual.any() == (set > 0) && actual.none() == (set == 0));
+        KDS_CHECK(actual.all() == (set == expected.size()));
+
+        std::vector<std::size_t> positions;
+        for (std::size_t pos{actual.find_first()}; pos != actual.npos; pos = actual.find_next(pos))
+            positions.push_back(pos);
+        std::vector<std::size_t> expected_positions;
+        for (std::size_t i{0}; i < expected.size(); ++i)
+            if (expected[i])
+                expected_positions.push_back(i);
+        KDS_CHECK(positions == expected_positions);
+    }
+
+    template<std::size_t N>
+    ksv::static_bitvector<N> random_bits(std::vector<bool> &expected)
+    {
+        ksv::static_bitvector<N> actual;
+        expected.clear();
+        for (std::size_t i{0}, size{kds_test::random<std::size_t>(0, N)}; i < size; ++i)
+        {
+            const bool value{kds_test::random(0, 2) == 0};
+            actual.push_back(value);
+            expected.push_back(value);
+        }
+        return actual;
+    }
+
+    // the shorter operand counts as padded with zero bits
+    template<typename Op>
+    std::vector<bool> combine(std::vector<bool> lhs, std::vector<bool> rhs, Op op)
+    {
+        const std::size_t size{std::max(lhs.size(), rhs.size())};
+        lhs.resize(size);
+        rhs.resize(size);
+        std::vector<bool> result(size);
+        for (std::size_t i{0}; i < size; ++i)
+            result[i] = op(static_cast<bool>(lhs[i]), static_cast<bool>(rhs[i]));
+        return result;
+    }
+
+    // capacities around the 64 bit word boundary leave a partial last word
+    template<std::size_t N>
+    void random_operations()
+    {
+        ksv::static_bitvector<N> actual;
+        std::vector<bool> expected;
+
+        for (int step{0}; step < 5000; ++step)
+        {
+            const std::size_t pos{expected.empty() ? 0 : kds_test::random<std::size_t>(0, expected.size() - 1)};
+            switch (kds_test::random(0, 9))
+            {
+                case 0:
+                case 1:
+                    if (expected.size() < N)
+                    {
+                        const bool value{kds_test::random(0, 1) == 0};
+                        actual.push_back(value);
+                        expected.push_back(value);
+                    }
+                    else
+                        KDS_CHECK_THROWS(std::length_error, actual.push_back(true));
+                    break;
+                case 2:
+                    if (!expected.empty())
+                    {
+                        actual.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 3:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, N)};
+                    const bool value{kds_test::random(0, 1) == 0};
+                    actual.resize(count, value);
+                    expected.resize(count, value);
+                    KDS_CHECK_THROWS(std::bad_alloc, actual.resize(N + 1));
+                    break;
+                }
+                case 4:
+                    if (!expected.empty())
+                    {
+                        const bool value{kds_test::random(0, 1) == 0};
+                        actual.set(pos, value);
+                        expected[pos] = value;
+                    }
+                    break;
+                case 5:
+                    if (!expected.empty())
+                    {
+                        actual.flip(pos);
+                        expected[pos] = !expected[pos];
+                        actual.reset(expected.size() - 1);
+                        expected.back() = false;
+                    }
+                    break;
+                case 6:
+                    if (!expected.empty())
+                    {
+                        // writes through the proxy and the iterators
+                        actual[pos] = !actual[pos];
+                        expected[pos] = !expected[pos];
+                        *(actual.begin() + static_cast<std::ptrdiff_t>(expected.size() - 1)) = true;
+                        expected.back() = true;
+                    }
+                    break;
+                case 7:
+                    switch (kds_test::random(0, 2))
+                    {
+                        case 0:
+                            actual.set();
+                            std::fill(expected.begin(), expected.end(), true);
+                            break;
+                        case 1:
+                            actual.reset();
+                            std::fill(expected.begin(), expected.end(), false);
+                            break;
+                        default:
+                            actual.flip();
+                            expected.flip();
+                            break;
+                    }
+                    break;
+                case 8:
+                {
+                    std::vector<bool> other_expected;
+                    const auto other{random_bits<N>(other_expected)};
+                    switch (kds_test::random(0, 2))
+                    {
+                        case 0:
+                            KDS_CHECK(same(actual & other, combine(expected, other_expected, std::bit_and<>{})));
+                            actual &= other;
+                            expected = combine(expected, other_expected, std::bit_and<>{});
+                            break;
+                        case 1:
+                            KDS_CHECK(same(actual | other, combine(expected, other_expected, std::bit_or<>{})));
+                            actual |= other;
+                            expected = combine(expected, other_expected, std::bit_or<>{});
+                            break;
+                        default:
+                            KDS_CHECK(same(actual ^ other, combine(expected, other_expected, std::bit_xor<>{})));
+                            actual ^= other;
+                            expected = combine(expected, other_expected, std::bit_xor<>{});
+                            break;
+                    }
+                    break;
+                }
+                case 9:
+                    if (kds_test::random(0, 30) == 0)
+                    {
+                        actual.clear();
+                        expected.clear();
+                    }
+                    break;
+            }
+            KDS_CHECK(same(actual, expected));
+            check_queries(actual, expected);
+            KDS_CHECK_THROWS(std::out_of_range, actual.test(expected.size()));
+            KDS_CHECK_THROWS(std::out_of_range, actual.set(expected.size()));
+        }
+
+        // equality sees the size as well as the bits
+        auto copy{actual};
+        KDS_CHECK(copy == actual);
+        if (copy.size() < N)
+        {
+            copy.push_back(false);
+            KDS_CHECK(!(copy == actual));
+        }
+        swap(copy, actual);
+        KDS_CHECK(same(copy, expected));
+    }
+
+}// namespace
+
+int main()
+{
+    random_operations<1>();
+    random_operations<63>();
+    random_operations<64>();
+    random_operations<65>();
+    random_operations<200>();
+}
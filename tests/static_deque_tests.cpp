@@ -0,0 +1,158 @@
+// Runtime checks of static_deque and ring_buffer against std::deque on randomized operations.
+
+#include "static_deque.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <deque>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+
+    template<typename T>
+    T make_value(int v)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::string(static_cast<std::size_t>(v % 40), static_cast<char>('a' + v % 26));
+        else
+            return static_cast<T>(v);
+    }
+
+    template<typename Deque, typename T>
+    bool same(const Deque &actual, const std::deque<T> &expected)
+    {
+        if (!std::ranges::equal(actual, expected) || !std::ranges::equal(actual.rbegin(), actual.rend(), expected.rbegin(), expected.rend()))
+            return false;
+        const auto [head, tail]{actual.as_spans()};
+        return head.size() + tail.size() == expected.size() && std::ranges::equal(head, expected | std::views::take(head.size())) &&
+               std::ranges::equal(tail, expected | std::views::drop(head.size()));
+    }
+
+    // pushes at both ends wrap the head around the buffer, for power of two
+    // capacities wrapped with a mask and for others wrapped with a compare
+    template<typename T, std::size_t N, bool OverwriteOldest>
+    void random_operations()
+    {
+        ksv::static_deque<T, N, OverwriteOldest> actual;
+        std::deque<T> expected;
+        ksv::static_deque<T, N, OverwriteOldest> snapshot;
+        std::deque<T> expected_snapshot;
+
+        for (int step{0}; step < 20000; ++step)
+        {
+            const T value{make_value<T>(step)};
+            switch (kds_test::random(0, 6))
+            {
+                case 0:
+                case 1:
+                    if (expected.size() == N)
+                    {
+                        if constexpr (!OverwriteOldest)
+                        {
+                            KDS_CHECK_THROWS(std::length_error, actual.push_back(value));
+                            break;
+                        }
+                        expected.pop_front();
+                    }
+                    actual.push_back(value);
+                    expected.push_back(value);
+                    break;
+                case 2:
+                case 3:
+                    if (expected.size() == N)
+                    {
+                        if constexpr (!OverwriteOldest)
+                        {
+                            KDS_CHECK_THROWS(std::length_error, actual.push_front(value));
+                            break;
+                        }
+                        expected.pop_back();
+                    }
+                    KDS_CHECK(actual.emplace_front(value) == value);
+                    expected.push_front(value);
+                    break;
+                case 4:
+                    if (!expected.empty())
+                    {
+                        actual.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 5:
+                    if (!expected.empty())
+                    {
+                        actual.pop_front();
+                        expected.pop_front();
+                    }
+                    break;
+                case 6:
+                {
+                    KDS_CHECK((actual == snapshot) == (expected == expected_snapshot));
+                    KDS_CHECK((actual <=> snapshot) == (expected <=> expected_snapshot));
+                    snapshot = actual;
+                    expected_snapshot = expected;
+                    auto moved{std::move(actual)};
+                    actual = snapshot;
+                    KDS_CHECK(moved == actual);
+                    break;
+                }
+            }
+            KDS_CHECK(actual.size() == expected.size());
+            KDS_CHECK(actual.full() == (expected.size() == N));
+            KDS_CHECK(same(actual, expected));
+        }
+    }
+
+    // a full ring buffer drops the oldest element, which the new one may be a copy of
+    void overwrite_from_self()
+    {
+        ksv::ring_buffer<std::string, 3> ring{"first-element-beyond-sso", "b", "c"};
+        ring.push_back(ring.front());
+        KDS_CHECK(ring == (ksv::ring_buffer<std::string, 3>{"b", "c", "first-element-beyond-sso"}));
+        ring.push_front(ring.back());
+        KDS_CHECK(ring == (ksv::ring_buffer<std::string, 3>{"first-element-beyond-sso", "b", "c"}));
+    }
+
+    void random_access()
+    {
+        ksv::static_deque<int, 12> actual;
+        std::deque<int> expected;
+        for (int i{0}; i < 8; ++i)
+        {
+            actual.push_front(i);
+            expected.push_front(i);
+        }
+        for (int i{0}; i < 4; ++i)
+        {
+            actual.push_back(-i);
+            expected.push_back(-i);
+        }
+        std::ranges::sort(actual);
+        std::ranges::sort(expected);
+        KDS_CHECK(same(actual, expected));
+        for (std::size_t i{0}; i < expected.size(); ++i)
+            KDS_CHECK(actual[i] == expected[i] && actual.at(i) == expected.at(i));
+        KDS_CHECK_THROWS(std::out_of_range, actual.at(12));
+        KDS_CHECK(actual.end() - actual.begin() == 12);
+    }
+
+}// namespace
+
+int main()
+{
+    random_operations<int, 8, false>();
+    random_operations<int, 7, false>();
+    random_operations<std::string, 8, false>();
+    random_operations<std::string, 5, false>();
+    random_operations<int, 8, true>();
+    random_operations<int, 7, true>();
+    random_operations<std::string, 4, true>();
+    random_operations<std::string, 5, true>();
+    overwrite_from_self();
+    random_access();
+}
@@ -0,0 +1,226 @@
+// Runtime checks of static_flat_map and static_flat_set against std::map and std::set on randomized operations.
+
+#include "static_flat_map.h"
+#include "static_flat_set.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <new>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+    template<typename K>
+    K make_key(int v)
+    {
+        if constexpr (std::is_same_v<K, std::string>)
+            return "key" + std::to_string(v);
+        else
+            return static_cast<K>(v);
+    }
+
+    template<typename Map, typename K, typename V>
+    bool same(const Map &actual, const std::map<K, V> &expected)
+    {
+        return actual.size() == expected.size() && std::ranges::equal(actual, expected, [](const auto &lhs, const auto &rhs) {
+                   return lhs.first == rhs.first && lhs.second == rhs.second;
+               });
+    }
+
+    // every lookup for keys in and around the stored ones, through the
+    // SIMD key search for small integral keys and binary search otherwise
+    template<typename Map, typename K, typename V>
+    void check_lookups(const Map &actual, const std::map<K, V> &expected, int max_key)
+    {
+        for (int v{-1}; v <= max_key + 1; ++v)
+        {
+            const K key{make_key<K>(v)};
+            const auto found{actual.find(key)};
+            const auto expected_found{expected.find(key)};
+            KDS_CHECK((found == actual.end()) == (expected_found == expected.end()));
+            if (found != actual.end())
+                KDS_CHECK((*found).second == expected_found->second);
+            KDS_CHECK(actual.contains(key) == expected.contains(key));
+            KDS_CHECK(actual.count(key) == expected.count(key));
+            KDS_CHECK(actual.lower_bound(key) - actual.begin() == std::distance(expected.begin(), expected.lower_bound(key)));
+            KDS_CHECK(actual.upper_bound(key) - actual.begin() == std::distance(expected.begin(), expected.upper_bound(key)));
+        }
+    }
+
+    template<typename K, std::size_t N>
+    void map_operations()
+    {
+        constexpr int max_key{3 * static_cast<int>(N)};
+        ksv::static_flat_map<K, int, N> actual;
+        std::map<K, int> expected;
+
+        for (int step{0}; step < 5000; ++step)
+        {
+            const int v{kds_test::random(0, max_key)};
+            const K key{make_key<K>(v)};
+            const bool room{expected.size() < N || expected.contains(key)};
+            switch (kds_test::random(0, 7))
+            {
+                case 0:
+                    if (room)
+                    {
+                        const auto [iter, inserted]{actual.try_emplace(key, step)};
+                        const auto [expected_iter, expected_inserted]{expected.try_emplace(key, step)};
+                        KDS_CHECK(inserted == expected_inserted && (*iter).second == expected_iter->second);
+                    }
+                    else
+                        KDS_CHECK_THROWS(std::exception, actual.try_emplace(key, step));
+                    break;
+                case 1:
+                    if (room)
+                        KDS_CHECK(actual.insert_or_assign(key, step).second == expected.insert_or_assign(key, step).second);
+                    break;
+                case 2:
+                    if (room)
+                    {
+                        actual[key] += step;
+                        expected[key] += step;
+                    }
+                    break;
+                case 3:
+                    KDS_CHECK(actual.erase(key) == expected.erase(key));
+                    break;
+                case 4:
+                    if (!expected.empty())
+                    {
+                        const auto pos{kds_test::random<std::ptrdiff_t>(0, static_cast<std::ptrdiff_t>(expected.size()) - 1)};
+                        const auto next{actual.erase(actual.begin() + pos)};
+                        KDS_CHECK(next - actual.begin() == pos);
+                        expected.erase(std::next(expected.begin(), pos));
+                    }
+                    break;
+                case 5:
+                case 6:
+                {
+                    // sorted batch of new and existing keys, merged in one pass
+                    std::map<K, int> batch;
+                    for (int i{0}, count{kds_test::random(0, 8)}; i < count; ++i)
+                        batch.emplace(make_key<K>(kds_test::random(0, max_key)), -step);
+                    std::map<K, int> merged{expected};
+                    merged.insert(batch.begin(), batch.end());
+                    if (merged.size() <= N)
+                    {
+                        actual.insert(ksv::sorted_unique, batch.begin(), batch.end());
+                        expected = merged;
+                    }
+                    else
+                        KDS_CHECK_THROWS(std::bad_alloc, actual.insert(ksv::sorted_unique, batch.begin(), batch.end()));
+                    break;
+                }
+                case 7:
+                    if (kds_test::random(0, 30) == 0)
+                    {
+                        actual.clear();
+                        expected.clear();
+                    }
+                    break;
+            }
+            KDS_CHECK(same(actual, expected));
+            KDS_CHECK(std::ranges::is_sorted(actual.keys()));
+        }
+        check_lookups(actual, expected, max_key);
+
+        // unsorted input with repeated keys keeps the first of each, like std::map
+        std::vector<std::pair<K, int>> unsorted;
+        for (int i{0}; i < 40; ++i)
+            unsorted.emplace_back(make_key<K>(kds_test::random(0, static_cast<int>(N) / 2)), i);
+        ksv::static_flat_map<K, int, N> from_unsorted(unsorted.begin(), unsorted.end());
+        KDS_CHECK(same(from_unsorted, std::map<K, int>(unsorted.begin(), unsorted.end())));
+        KDS_CHECK_THROWS(std::out_of_range, from_unsorted.at(make_key<K>(max_key + 1)));
+    }
+
+    template<typename K, std::size_t N>
+    void set_operations()
+    {
+        constexpr int max_key{3 * static_cast<int>(N)};
+        ksv::static_flat_set<K, N> actual;
+        std::set<K> expected;
+
+        for (int step{0}; step < 5000; ++step)
+        {
+            const K key{make_key<K>(kds_test::random(0, max_key))};
+            switch (kds_test::random(0, 3))
+            {
+                case 0:
+                    if (expected.size() < N || expected.contains(key))
+                        KDS_CHECK(actual.insert(key).second == expected.insert(key).second);
+                    break;
+                case 1:
+                    KDS_CHECK(actual.erase(key) == expected.erase(key));
+                    break;
+                case 2:
+                {
+                    std::set<K> batch;
+                    for (int i{0}, count{kds_test::random(0, 8)}; i < count; ++i)
+                        batch.insert(make_key<K>(kds_test::random(0, max_key)));
+                    std::set<K> merged{expected};
+                    merged.insert(batch.begin(), batch.end());
+                    if (merged.size() <= N)
+                    {
+                        actual.insert(ksv::sorted_unique, batch.begin(), batch.end());
+                        expected = merged;
+                    }
+                    else
+                        KDS_CHECK_THROWS(std::bad_alloc, actual.insert(ksv::sorted_unique, batch.begin(), batch.end()));
+                    break;
+                }
+                case 3:
+                    if (kds_test::random(0, 30) == 0)
+                    {
+                        actual.clear();
+                        expected.clear();
+                    }
+                    break;
+            }
+            KDS_CHECK(std::ranges::equal(actual, expected));
+        }
+        for (int v{-1}; v <= max_key + 1; ++v)
+        {
+            const K key{make_key<K>(v)};
+            KDS_CHECK(actual.contains(key) == expected.contains(key));
+            KDS_CHECK(actual.lower_bound(key) - actual.begin() == std::distance(expected.begin(), expected.lower_bound(key)));
+            KDS_CHECK(actual.upper_bound(key) - actual.begin() == std::distance(expected.begin(), expected.upper_bound(key)));
+        }
+    }
+
+    // transparent comparators look up and erase by string_view without building keys
+    void heterogeneous_lookup()
+    {
+        ksv::static_flat_map<std::string, int, 8, std::less<>> map{{"b", 2}, {"a", 1}, {"c", 3}};
+        KDS_CHECK(map.contains(std::string_view{"b"}) && !map.contains(std::string_view{"d"}));
+        KDS_CHECK(map.at(std::string_view{"c"}) == 3);
+        KDS_CHECK(map.erase(std::string_view{"a"}) == 1);
+        KDS_CHECK(map.lower_bound(std::string_view{"a"}) == map.begin());
+
+        ksv::static_flat_set<std::string, 8, std::less<>> set{"y", "x"};
+        KDS_CHECK(set.count(std::string_view{"x"}) == 1);
+        KDS_CHECK(set.erase(std::string_view{"y"}) == 1 && set.size() == 1);
+    }
+
+}// namespace
+
+int main()
+{
+    map_operations<std::int32_t, 16>();
+    map_operations<std::uint8_t, 40>();
+    map_operations<std::int16_t, 64>();
+    map_operations<std::string, 24>();
+    set_operations<std::int32_t, 48>();
+    set_operations<float, 20>();
+    set_operations<std::string, 16>();
+    heterogeneous_lookup();
+}
@@ -0,0 +1,191 @@
+// Runtime checks of static_packed_vector against std::vector<std::uint32_t> on randomized operations.
+
+#include "static_packed_vector.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+    // values near both ends of the range, so the high bits that straddle
+    // into the next word are exercised as often as the low ones
+    template<std::size_t Bits>
+    std::uint32_t random_value()
+    {
+        constexpr std::uint32_t max_value{static_cast<std::uint32_t>((std::uint64_t{1} << Bits) - 1)};
+        switch (kds_test::random(0, 3))
+        {
+            case 0:
+                return 0;
+            case 1:
+                return max_value;
+            default:
+                return kds_test::random<std::uint32_t>(0, max_value);
+        }
+    }
+
+    // the words must hold the values back to back, bit i of value k at bit
+    // k * Bits + i, with every bit past the last value zero
+    template<std::size_t Bits, std::size_t N>
+    bool same_words(const ksv::static_packed_vector<Bits, N> &actual, const std::vector<std::uint32_t> &expected)
+    {
+        std::vector<std::uint64_t> words(actual.words().size());
+        for (std::size_t k{0}; k < expected.size(); ++k)
+            for (std::size_t i{0}; i < Bits; ++i)
+                if ((expected[k] >> i) & 1)
+                    words[(k * Bits + i) / 64] |= std::uint64_t{1} << ((k * Bits + i) % 64);
+        return std::ranges::equal(actual.words(), words);
+    }
+
+    template<std::size_t Bits, std::size_t N>
+    void check_unpack(const ksv::static_packed_vector<Bits, N> &actual, const std::vector<std::uint32_t> &expected)
+    {
+        ksv::static_vector<std::uint32_t, N> out(N / 2, 7);
+        actual.unpack(out);
+        KDS_CHECK(std::ranges::equal(out, expected));
+
+#if defined(KSV_X86_DISPATCH)
+        // the dispatch only takes the AVX2 path where the CPU has it, check it
+        // directly, the zero word after the packed ones is readable as well
+        if constexpr (ksv::detail::avx2_unpackable<Bits>)
+            if (__builtin_cpu_supports("avx2"))
+            {
+                std::vector<std::uint32_t> lanes(expected.size());
+                const std::size_t readable{(actual.words().size() + 1) * sizeof(std::uint64_t)};
+                const std::size_t unpacked{ksv::detail::unpack_avx2<Bits>(actual.words().data(), readable, expected.size(), lanes.data())};
+                KDS_CHECK(unpacked % 8 == 0 && unpacked <= expected.size());
+                KDS_CHECK(std::equal(lanes.begin(), lanes.begin() + static_cast<std::ptrdiff_t>(unpacked), expected.begin()));
+                if (expected.size() >= 8 && ksv::detail::unpack_lanes<Bits>::high_byte + 16 <= readable)
+                    KDS_CHECK(unpacked > 0);
+            }
+#endif
+    }
+
+    // widths with odd periods leave a partial period at the end of most sizes
+    template<std::size_t Bits, std::size_t N>
+    void random_operations()
+    {
+        using vector = ksv::static_packed_vector<Bits, N>;
+        constexpr std::uint32_t max_value{vector::max_value};
+        vector actual;
+        std::vector<std::uint32_t> expected;
+
+        for (int step{0}; step < 3000; ++step)
+        {
+            switch (kds_test::random(0, 8))
+            {
+                case 0:
+                case 1:
+                    if (expected.size() < N)
+                    {
+                        const std::uint32_t value{random_value<Bits>()};
+                        actual.push_back(value);
+                        expected.push_back(value);
+                    }
+                    else
+                        KDS_CHECK_THROWS(std::length_error, actual.push_back(0));
+                    break;
+                case 2:
+                    if (!expected.empty())
+                    {
+                        actual.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 3:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, N)};
+                    const std::uint32_t value{random_value<Bits>()};
+                    actual.resize(count, value);
+                    expected.resize(count, value);
+                    KDS_CHECK_THROWS(std::bad_alloc, actual.resize(N + 1));
+                    break;
+                }
+                case 4:
+                    if (!expected.empty())
+                    {
+                        const auto pos{kds_test::random<std::size_t>(0, expected.size() - 1)};
+                        const std::uint32_t value{random_value<Bits>()};
+                        actual.set(pos, value);
+                        expected[pos] = value;
+                        if constexpr (Bits < 32)
+                            KDS_CHECK_THROWS(std::out_of_range, actual.set(pos, max_value + 1));
+                    }
+                    break;
+                case 5:
+                    if (!expected.empty())
+                    {
+                        // the proxy truncates to Bits bits
+                        const auto pos{kds_test::random<std::size_t>(0, expected.size() - 1)};
+                        const std::uint32_t value{kds_test::random<std::uint32_t>(0, 0xffffffff)};
+                        *(actual.begin() + static_cast<std::ptrdiff_t>(pos)) = value;
+                        expected[pos] = value & max_value;
+                    }
+                    break;
+                case 6:
+                {
+                    // whole periods are packed unrolled, the rest value by value
+                    ksv::static_vector<std::uint32_t, N> values;
+                    for (std::size_t i{0}, size{kds_test::random<std::size_t>(0, N)}; i < size; ++i)
+                        values.push_back(random_value<Bits>());
+                    actual.pack(values);
+                    expected.assign(values.begin(), values.end());
+                    KDS_CHECK(vector(values) == actual);
+                    if constexpr (Bits < 32)
+                        if (!values.empty())
+                        {
+                            values[kds_test::random<std::size_t>(0, values.size() - 1)] = max_value + 1;
+                            vector rejected{actual};
+                            KDS_CHECK_THROWS(std::out_of_range, rejected.pack(values));
+                            KDS_CHECK(rejected.empty() && std::ranges::all_of(rejected.words(), [](std::uint64_t word) { return word == 0; }));
+                        }
+                    break;
+                }
+                case 7:
+                {
+                    auto copy{actual};
+                    KDS_CHECK(copy == actual);
+                    vector other(kds_test::random<std::size_t>(0, N), random_value<Bits>());
+                    swap(copy, other);
+                    KDS_CHECK(other == actual);
+                    break;
+                }
+                case 8:
+                    if (kds_test::random(0, 30) == 0)
+                    {
+                        actual.clear();
+                        expected.clear();
+                    }
+                    break;
+            }
+            KDS_CHECK(actual.size() == expected.size() && std::ranges::equal(actual, expected));
+            KDS_CHECK(same_words(actual, expected));
+            KDS_CHECK_THROWS(std::out_of_range, actual.at(expected.size()));
+            if (step % 10 == 0)
+                check_unpack(actual, expected);
+        }
+    }
+
+}// namespace
+
+int main()
+{
+    random_operations<1, 130>();
+    random_operations<3, 100>();
+    random_operations<5, 77>();
+    random_operations<7, 64>();
+    random_operations<8, 33>();
+    random_operations<12, 50>();
+    random_operations<13, 129>();
+    random_operations<17, 70>();
+    random_operations<24, 19>();
+    random_operations<25, 71>();
+    random_operations<31, 40>();
+    random_operations<32, 9>();
+}
@@ -0,0 +1,151 @@
+// Runtime checks of static_priority_queue against std::priority_queue on randomized operations.
+
+#include "static_priority_queue.h"
+#include "test_support.h"
+
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+    template<typename T>
+    T make_value(int v)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::to_string(v);
+        else
+            return static_cast<T>(v);
+    }
+
+    // no element compares before its parent
+    template<typename Queue, typename Compare>
+    bool is_heap(const Queue &actual, const Compare &comp)
+    {
+        const auto &values{actual.values()};
+        for (std::size_t i{1}; i < values.size(); ++i)
+            if (comp(values[(i - 1) / Queue::arity], values[i]))
+                return false;
+        return true;
+    }
+
+    // ties are common, only the values of the tops have to agree
+    template<typename T, std::size_t N, typename Compare, std::size_t Arity>
+    void random_operations()
+    {
+        using queue = ksv::static_priority_queue<T, N, Compare, Arity>;
+        using reference = std::priority_queue<T, std::vector<T>, Compare>;
+        queue actual;
+        reference expected;
+        const Compare comp{};
+
+        for (int step{0}; step < 5000; ++step)
+        {
+            const T value{make_value<T>(kds_test::random(0, 3 * static_cast<int>(N)))};
+            switch (kds_test::random(0, 7))
+            {
+                case 0:
+                case 1:
+                    if (expected.size() < N)
+                    {
+                        actual.push(value);
+                        expected.push(value);
+                    }
+                    else
+                        KDS_CHECK_THROWS(std::length_error, actual.push(value));
+                    break;
+                case 2:
+                    if (expected.size() < N)
+                    {
+                        actual.emplace(value);
+                        expected.emplace(value);
+                    }
+                    break;
+                case 3:
+                    if (!expected.empty())
+                    {
+                        actual.pop();
+                        expected.pop();
+                    }
+                    break;
+                case 4:
+                    // an empty queue only gets the value pushed
+                    if (expected.empty())
+                    {
+                        actual.replace_top(value);
+                        KDS_CHECK(actual.size() == 1 && actual.top() == value);
+                        expected.push(value);
+                    }
+                    else
+                    {
+                        actual.replace_top(value);
+                        expected.pop();
+                        expected.push(value);
+                    }
+                    break;
+                case 5:
+                    if (!expected.empty())
+                    {
+                        // moves an element towards the top, the reference is rebuilt
+                        const auto idx{kds_test::random<std::size_t>(0, actual.size() - 1)};
+                        std::vector<T> values(actual.values().begin(), actual.values().end());
+                        if (!comp(value, values[idx]))
+                        {
+                            actual.decrease_key(idx, value);
+                            values[idx] = value;
+                            expected = reference(comp, std::move(values));
+                        }
+                    }
+                    KDS_CHECK_THROWS(std::out_of_range, actual.decrease_key(actual.size(), value));
+                    break;
+                case 6:
+                {
+                    // bottom up construction from an unordered range
+                    std::vector<T> values;
+                    for (std::size_t i{0}, size{kds_test::random<std::size_t>(0, N)}; i < size; ++i)
+                        values.push_back(make_value<T>(kds_test::random(0, 3 * static_cast<int>(N))));
+                    if (kds_test::random(0, 1) == 0)
+                        actual.heapify(values.begin(), values.end());
+                    else
+                        actual = queue(values.begin(), values.end());
+                    expected = reference(values.begin(), values.end());
+                    break;
+                }
+                case 7:
+                    if (kds_test::random(0, 30) == 0)
+                    {
+                        actual.clear();
+                        expected = reference();
+                    }
+                    break;
+            }
+            KDS_CHECK(actual.size() == expected.size());
+            KDS_CHECK(actual.empty() || actual.top() == expected.top());
+            KDS_CHECK(is_heap(actual, comp));
+        }
+
+        // draining yields the elements in priority order
+        while (!expected.empty())
+        {
+            KDS_CHECK(actual.top() == expected.top());
+            actual.pop();
+            expected.pop();
+        }
+        KDS_CHECK(actual.empty());
+    }
+
+}// namespace
+
+int main()
+{
+    random_operations<int, 64, std::less<int>, 4>();
+    random_operations<int, 37, std::greater<int>, 2>();
+    random_operations<int, 100, std::less<int>, 8>();
+    random_operations<int, 1, std::less<int>, 4>();
+    random_operations<std::string, 50, std::less<std::string>, 3>();
+    random_operations<std::string, 20, std::greater<std::string>, 4>();
+}
@@ -0,0 +1,78 @@
+// Runtime checks of static_search_index against std::lower_bound on the sorted elements.
+
+#include "static_search_index.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+    template<typename T>
+    T make_key(int v)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::string(static_cast<std::size_t>(v + 200) / 40, 'k') + std::to_string(v + 200);
+        else
+            return static_cast<T>(v);
+    }
+
+    // every size up to the capacity, so the last node is padded with copies
+    // of the last element at all fill levels and the tree has partial levels;
+    // one index is rebuilt at each size to check nothing of a larger build remains
+    template<typename T, std::size_t N, typename Compare = std::less<T>>
+    void lower_bounds()
+    {
+        using index = ksv::static_search_index<T, N, Compare>;
+        const Compare comp{};
+        index rebuilt;
+        for (std::size_t size{N + 1}; size-- > 0;)
+        {
+            for (int round{0}; round < 4; ++round)
+            {
+                // sparse keys leave gaps to search for, dense ones repeat, both
+                // stay within the range of the 1 byte keys
+                const int spread{round % 2 == 0 ? std::min(3 * static_cast<int>(N), 120) : static_cast<int>(N) / 4 + 1};
+                ksv::static_vector<T, N> sorted;
+                for (std::size_t i{0}; i < size; ++i)
+                    sorted.push_back(make_key<T>(kds_test::random(-spread, spread)));
+                std::ranges::sort(sorted, comp);
+
+                const index fresh(sorted, comp);
+                rebuilt.build(sorted);
+                KDS_CHECK(fresh.size() == size && rebuilt.size() == size);
+                for (int v{-spread - 1}; v <= spread + 1; ++v)
+                {
+                    const T key{make_key<T>(v)};
+                    const auto expected{static_cast<std::size_t>(std::ranges::lower_bound(sorted, key, comp) - sorted.begin())};
+                    const bool expected_contains{std::ranges::binary_search(sorted, key, comp)};
+                    KDS_CHECK(fresh.lower_bound(key) == expected && rebuilt.lower_bound(key) == expected);
+                    KDS_CHECK(fresh.contains(key) == expected_contains && rebuilt.contains(key) == expected_contains);
+                }
+            }
+        }
+    }
+
+}// namespace
+
+int main()
+{
+    // node_size is 64 keys for 1 byte keys down to 8 for 8 byte ones, the
+    // SSE2 node search covers the arithmetic ones under std::less
+    lower_bounds<std::int8_t, 130>();
+    lower_bounds<std::uint8_t, 70>();
+    lower_bounds<std::int16_t, 100>();
+    lower_bounds<std::uint16_t, 33>();
+    lower_bounds<std::int32_t, 300>();
+    lower_bounds<std::uint32_t, 17>();
+    lower_bounds<std::int64_t, 90>();
+    lower_bounds<float, 50>();
+    lower_bounds<double, 81>();
+    lower_bounds<std::int32_t, 100, std::greater<std::int32_t>>();
+    lower_bounds<std::string, 40>();
+}
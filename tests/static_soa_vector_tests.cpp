@@ -0,0 +1,165 @@
+// Runtime checks of static_soa_vector against a std::vector of tuples on randomized operations.
+
+#include "static_soa_vector.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+    template<typename T>
+    T make_field(int v)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::string(static_cast<std::size_t>(v % 30), static_cast<char>('a' + v % 26));
+        else
+            return static_cast<T>(v);
+    }
+
+    template<typename Vec, typename... Fields>
+    bool same(const Vec &actual, const std::vector<std::tuple<Fields...>> &expected)
+    {
+        if (actual.size() != expected.size())
+            return false;
+        for (std::size_t i{0}; i < expected.size(); ++i)
+            if (std::tuple<Fields...>(actual[i]) != expected[i])
+                return false;
+        // each column holds the matching field of every row
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (std::ranges::equal(actual.template column<Is>(), expected, {}, {}, [](const auto &row) { return std::get<Is>(row); }) && ...);
+        }(std::index_sequence_for<Fields...>{});
+    }
+
+    // trivially copyable rows copy and move column by column as raw bytes,
+    // the others row by row
+    template<std::size_t N, typename... Fields>
+    void random_operations()
+    {
+        using vector = ksv::static_soa_vector<N, Fields...>;
+        using row = std::tuple<Fields...>;
+        vector actual;
+        std::vector<row> expected;
+
+        for (int step{0}; step < 5000; ++step)
+        {
+            const row values{make_field<Fields>(kds_test::random(0, 1000))...};
+            switch (kds_test::random(0, 7))
+            {
+                case 0:
+                case 1:
+                    if (expected.size() < N)
+                    {
+                        actual.push_back(values);
+                        expected.push_back(values);
+                    }
+                    else
+                        KDS_CHECK_THROWS(std::length_error, actual.push_back(values));
+                    break;
+                case 2:
+                    if (expected.size() < N)
+                    {
+                        std::apply([&](const Fields &...fields) { actual.emplace_back(fields...); }, values);
+                        expected.push_back(values);
+                    }
+                    break;
+                case 3:
+                    if (!expected.empty())
+                    {
+                        actual.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 4:
+                    if (!expected.empty())
+                    {
+                        // assignment through a row of references and through an iterator
+                        const auto pos{kds_test::random<std::size_t>(0, expected.size() - 1)};
+                        actual[pos] = values;
+                        expected[pos] = values;
+                        std::get<0>(*(actual.end() - 1)) = std::get<0>(values);
+                        std::get<0>(expected.back()) = std::get<0>(values);
+                    }
+                    break;
+                case 5:
+                {
+                    // the random access iterators work with the std::ranges algorithms
+                    constexpr std::size_t last{sizeof...(Fields) - 1};
+                    const auto key{std::get<last>(values)};
+                    const auto found{std::ranges::find(actual, key, [](const auto &fields) { return std::get<last>(fields); })};
+                    const auto expected_found{std::ranges::find(expected, key, [](const row &fields) { return std::get<last>(fields); })};
+                    KDS_CHECK(found - actual.begin() == expected_found - expected.begin());
+                    KDS_CHECK(std::ranges::equal(actual | std::views::reverse, expected | std::views::reverse, [](const auto &lhs, const row &rhs) { return row(lhs) == rhs; }));
+                    break;
+                }
+                case 6:
+                {
+                    const vector copy{actual};
+                    KDS_CHECK(copy == actual);
+                    vector moved{std::move(actual)};
+                    KDS_CHECK(actual.empty());
+                    actual = copy;
+                    KDS_CHECK(moved == actual);
+                    vector other;
+                    other.push_back(values);
+                    swap(other, actual);
+                    KDS_CHECK(other == moved && actual.size() == 1);
+                    swap(other, actual);
+                    break;
+                }
+                case 7:
+                    if (kds_test::random(0, 30) == 0)
+                    {
+                        actual.clear();
+                        expected.clear();
+                    }
+                    break;
+            }
+            KDS_CHECK(same(actual, expected));
+        }
+        KDS_CHECK_THROWS(std::out_of_range, actual.at(expected.size()));
+    }
+
+    // a field that throws while a row is built leaves no part of it behind,
+    // and a copy that fails part way leaves the target empty
+    void exception_rollback()
+    {
+        using kds_test::tracked;
+        using vector = ksv::static_soa_vector<8, tracked, std::string, tracked>;
+        const int live{tracked::live};
+        {
+            vector vec;
+            vec.emplace_back(tracked{1}, "one", tracked{2});
+            const tracked first{3};
+            const tracked second{4};
+            tracked::copies_until_throw = 1;
+            KDS_CHECK_THROWS(std::runtime_error, vec.emplace_back(first, "two", second));
+            KDS_CHECK(vec.size() == 1 && tracked::live == live + 4);
+
+            for (int i{0}; i < 5; ++i)
+                vec.emplace_back(tracked{i}, std::to_string(i), tracked{i});
+            tracked::copies_until_throw = 5;
+            KDS_CHECK_THROWS(std::runtime_error, vector{vec});
+            KDS_CHECK(tracked::live == live + 14);
+        }
+        KDS_CHECK(tracked::live == live);
+    }
+
+}// namespace
+
+int main()
+{
+    random_operations<16, int, double, char>();
+    random_operations<5, std::uint8_t, std::int64_t>();
+    random_operations<40, std::string, int, std::string>();
+    random_operations<1, std::string>();
+    exception_rollback();
+}
@@ -0,0 +1,133 @@
+// Runtime checks of basic_static_string against std::string on randomized operations.
+
+#include "static_string.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace
+{
+
+    // a two letter alphabet makes partial and repeated matches common
+    std::string random_text(std::size_t max_size)
+    {
+        std::string text(kds_test::random<std::size_t>(0, max_size), 'a');
+        for (char &ch : text)
+            ch = kds_test::random(0, 3) == 0 ? 'b' : 'a';
+        return text;
+    }
+
+    template<std::size_t N>
+    void check_searches(const ksv::static_string<N> &actual, const std::string &expected)
+    {
+        for (std::size_t pos{0}; pos <= expected.size() + 1; ++pos)
+        {
+            KDS_CHECK(actual.find('b', pos) == expected.find('b', pos));
+            KDS_CHECK(actual.find('c', pos) == expected.find('c', pos));
+        }
+        for (int round{0}; round < 4; ++round)
+        {
+            const std::string needle{random_text(6)};
+            const auto pos{kds_test::random<std::size_t>(0, expected.size() + 1)};
+            KDS_CHECK(actual.find(needle, pos) == expected.find(needle, pos));
+            KDS_CHECK(actual.find(needle) == expected.find(needle));
+            KDS_CHECK(actual.rfind(needle) == expected.rfind(needle));
+            KDS_CHECK(actual.contains(needle) == (expected.find(needle) != std::string::npos));
+            KDS_CHECK(actual.starts_with(needle) == expected.starts_with(needle));
+            KDS_CHECK(actual.ends_with(needle) == expected.ends_with(needle));
+            KDS_CHECK((actual <=> needle) == (expected <=> needle));
+            KDS_CHECK((actual == needle.c_str()) == (expected == needle));
+            KDS_CHECK((actual.compare(needle) < 0) == (expected.compare(needle) < 0));
+        }
+    }
+
+    // N = 15 keeps the size in the spare last byte and searches with the
+    // standard library, N = 64 uses the SIMD searches, N = 300 both SIMD and a
+    // separate size field
+    template<std::size_t N>
+    void random_operations()
+    {
+        ksv::static_string<N> actual;
+        std::string expected;
+
+        for (int step{0}; step < 5000; ++step)
+        {
+            const std::size_t room{N - expected.size()};
+            switch (kds_test::random(0, 7))
+            {
+                case 0:
+                    if (room > 0)
+                    {
+                        const char ch{kds_test::random(0, 1) == 0 ? 'a' : 'b'};
+                        actual.push_back(ch);
+                        expected.push_back(ch);
+                    }
+                    else
+                        KDS_CHECK_THROWS(std::length_error, actual.push_back('a'));
+                    break;
+                case 1:
+                {
+                    const std::string text{random_text(std::min<std::size_t>(room, 20))};
+                    actual += text;
+                    expected += text;
+                    break;
+                }
+                case 2:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, std::min<std::size_t>(room, 20))};
+                    actual.append(count, 'b');
+                    expected.append(count, 'b');
+                    break;
+                }
+                case 3:
+                    if (!expected.empty())
+                    {
+                        actual.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 4:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, N)};
+                    actual.resize(count, 'a');
+                    expected.resize(count, 'a');
+                    break;
+                }
+                case 5:
+                {
+                    const std::string text{random_text(N)};
+                    actual.assign(text);
+                    expected.assign(text);
+                    break;
+                }
+                case 6:
+                    if (room >= 20)
+                    {
+                        const long long number{kds_test::random(-1000000LL, 1000000LL)};
+                        actual.append_number(number);
+                        expected += std::to_string(number);
+                    }
+                    break;
+                case 7:
+                    KDS_CHECK_THROWS(std::length_error, actual.append(room + 1, 'a'));
+                    break;
+            }
+            KDS_CHECK(actual == expected && actual.size() == expected.size());
+            KDS_CHECK(actual.c_str()[actual.size()] == '\0');
+            check_searches(actual, expected);
+        }
+    }
+
+}// namespace
+
+int main()
+{
+    random_operations<15>();
+    random_operations<64>();
+    random_operations<300>();
+}
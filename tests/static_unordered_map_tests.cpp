@@ -0,0 +1,163 @@
+// Runtime checks of static_unordered_map against std::unordered_map on randomized operations.
+
+#include "static_unordered_map.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+    // few distinct hashes give long probe runs that wrap around the end of
+    // the slots, so erasing has to shift elements back across the wrap
+    struct clustering_hash
+    {
+        std::size_t buckets{4};
+
+        std::size_t operator()(int key) const noexcept { return static_cast<std::size_t>(key) % buckets; }
+
+        std::size_t operator()(const std::string &key) const noexcept { return key.size() % buckets; }
+    };
+
+    template<typename K>
+    K make_key(int v)
+    {
+        if constexpr (std::is_same_v<K, std::string>)
+            return std::string(static_cast<std::size_t>(v % 7), 'k') + std::to_string(v);
+        else
+            return static_cast<K>(v);
+    }
+
+    template<typename Map, typename K, typename V>
+    bool same(const Map &actual, const std::unordered_map<K, V> &expected)
+    {
+        if (actual.size() != expected.size())
+            return false;
+        std::size_t visited{0};
+        for (const auto &[key, value] : actual)
+        {
+            const auto found{expected.find(key)};
+            if (found == expected.end() || found->second != value)
+                return false;
+            ++visited;
+        }
+        return visited == expected.size();
+    }
+
+    template<typename K, std::size_t N, typename Hash>
+    void random_operations(const Hash &hash)
+    {
+        constexpr int max_key{2 * static_cast<int>(N)};
+        ksv::static_unordered_map<K, std::string, N, Hash> actual(0, hash);
+        std::unordered_map<K, std::string> expected;
+
+        for (int step{0}; step < 20000; ++step)
+        {
+            const K key{make_key<K>(kds_test::random(0, max_key))};
+            const std::string value(static_cast<std::size_t>(step % 30), 'v');
+            const bool room{expected.size() < N || expected.contains(key)};
+            switch (kds_test::random(0, 6))
+            {
+                case 0:
+                case 1:
+                    if (room)
+                    {
+                        const auto [iter, inserted]{actual.try_emplace(key, value)};
+                        const auto [expected_iter, expected_inserted]{expected.try_emplace(key, value)};
+                        KDS_CHECK(inserted == expected_inserted && iter->second == expected_iter->second);
+                    }
+                    else
+                    {
+                        const auto [iter, inserted]{actual.try_emplace(key, value)};
+                        KDS_CHECK(iter == actual.end() && !inserted);
+                        KDS_CHECK_THROWS(std::length_error, actual.insert({key, value}));
+                    }
+                    break;
+                case 2:
+                    if (room)
+                        KDS_CHECK(actual.insert_or_assign(key, value).second == expected.insert_or_assign(key, value).second);
+                    break;
+                case 3:
+                case 4:
+                    KDS_CHECK(actual.erase(key) == expected.erase(key));
+                    break;
+                case 5:
+                    if (!expected.empty())
+                    {
+                        // erase through an iterator to an arbitrary element
+                        auto iter{actual.begin()};
+                        for (auto skip{kds_test::random<std::size_t>(0, expected.size() - 1)}; skip > 0; --skip)
+                            ++iter;
+                        const K erased{iter->first};
+                        actual.erase(iter);
+                        KDS_CHECK(expected.erase(erased) == 1);
+                    }
+                    break;
+                case 6:
+                {
+                    const auto copy{actual};
+                    KDS_CHECK(copy == actual);
+                    auto moved{std::move(actual)};
+                    actual = copy;
+                    KDS_CHECK(moved == actual);
+                    break;
+                }
+            }
+            KDS_CHECK(same(actual, expected));
+            KDS_CHECK(actual.full() == (expected.size() == N));
+        }
+
+        for (int v{0}; v <= max_key; ++v)
+        {
+            const K key{make_key<K>(v)};
+            KDS_CHECK(actual.contains(key) == expected.contains(key));
+            if (expected.contains(key))
+                KDS_CHECK(actual.at(key) == expected.at(key));
+            else
+                KDS_CHECK_THROWS(std::out_of_range, actual.at(key));
+        }
+    }
+
+    // emptying a full map one key at a time in random order leaves no key
+    // stranded behind a hole in its probe run
+    template<std::size_t N>
+    void drain_full(const clustering_hash &hash)
+    {
+        for (int round{0}; round < 50; ++round)
+        {
+            ksv::static_unordered_map<int, int, N, clustering_hash> actual(0, hash);
+            std::vector<int> keys;
+            for (int i{0}; static_cast<std::size_t>(i) < N; ++i)
+            {
+                keys.push_back(i * 1000 + kds_test::random(0, 999));// distinct
+                actual.try_emplace(keys.back(), i);
+            }
+            std::ranges::shuffle(keys, kds_test::rng());
+            for (std::size_t i{0}; i < keys.size(); ++i)
+            {
+                actual.erase(keys[i]);
+                for (std::size_t j{i + 1}; j < keys.size(); ++j)
+                    KDS_CHECK(actual.contains(keys[j]));
+            }
+            KDS_CHECK(actual.empty() && actual.begin() == actual.end());
+        }
+    }
+
+}// namespace
+
+int main()
+{
+    random_operations<int, 16>(std::hash<int>{});
+    random_operations<int, 56>(clustering_hash{});
+    random_operations<int, 24>(clustering_hash{1});
+    random_operations<std::string, 32>(std::hash<std::string>{});
+    random_operations<std::string, 20>(clustering_hash{3});
+    drain_full<15>(clustering_hash{2});
+    drain_full<64>(clustering_hash{5});
+}
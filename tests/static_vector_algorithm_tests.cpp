@@ -0,0 +1,141 @@
+// Runtime checks of ksv::find, ksv::count and ksv::sort against the std algorithms.
+
+#include "static_vector_algorithm.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+    // values from a small range so that matches are frequent, and for floating
+    // point types the ones equality treats specially
+    template<typename T>
+    T random_value()
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            switch (kds_test::random(0, 9))
+            {
+                case 0:
+                    return std::numeric_limits<T>::quiet_NaN();
+                case 1:
+                    return T(-0.0);
+                default:
+                    return static_cast<T>(kds_test::random(-4, 4));
+            }
+        }
+        else
+            return static_cast<T>(kds_test::random(-4, 4));
+    }
+
+    // random sizes up to the capacity, so the valid lanes of the last block and
+    // the scalar tail past the last whole block are both exercised
+    template<typename T, std::size_t N>
+    void searches()
+    {
+        for (int round{0}; round < 300; ++round)
+        {
+            ksv::static_vector<T, N> vec;
+            for (std::size_t i{0}, size{kds_test::random<std::size_t>(0, N)}; i < size; ++i)
+                vec.push_back(random_value<T>());
+            // stale values past size() must not be reported
+            if (!vec.empty() && kds_test::random(0, 1) == 0)
+            {
+                const T last{vec.back()};
+                vec.pop_back();
+                KDS_CHECK(ksv::count(vec, last) == static_cast<std::size_t>(std::ranges::count(vec, last)));
+            }
+
+            const T value{random_value<T>()};
+            const T other{random_value<T>()};
+            KDS_CHECK(ksv::find(vec, value) == std::ranges::find(vec, value));
+            KDS_CHECK(ksv::find(std::as_const(vec), value) == std::ranges::find(std::as_const(vec), value));
+            KDS_CHECK(ksv::count(vec, value) == static_cast<std::size_t>(std::ranges::count(vec, value)));
+            KDS_CHECK(ksv::contains(vec, value) == (std::ranges::find(vec, value) != vec.end()));
+            KDS_CHECK(ksv::find_if_eq_any(vec, value, other) == std::ranges::find_if(vec, [&](const T &elem) { return elem == value || elem == other; }));
+
+#if defined(KSV_X86_DISPATCH)
+            // the dispatch picks AVX2 where the CPU has it, check SSE2 and AVX2 separately
+            const std::array<T, 1> needles{value};
+            const auto expected_index{static_cast<std::size_t>(std::ranges::find(vec, value) - vec.begin())};
+            const auto expected_count{static_cast<std::size_t>(std::ranges::count(vec, value))};
+            if constexpr (ksv::detail::simd_element<T>)
+            {
+                KDS_CHECK((ksv::detail::scan_sse2<false, N>(vec.data(), vec.size(), needles)) == expected_index);
+                KDS_CHECK((ksv::detail::scan_sse2<true, N>(vec.data(), vec.size(), needles)) == expected_count);
+                if constexpr (N * sizeof(T) >= 32)
+                    if (__builtin_cpu_supports("avx2"))
+                    {
+                        KDS_CHECK((ksv::detail::scan_avx2<false, N>(vec.data(), vec.size(), needles)) == expected_index);
+                        KDS_CHECK((ksv::detail::scan_avx2<true, N>(vec.data(), vec.size(), needles)) == expected_count);
+                    }
+            }
+#endif
+        }
+    }
+
+    // every size from 0 to 64 crosses from the sorting networks to std::sort,
+    // and each capacity picks a different network bucket
+    template<typename T, std::size_t N>
+    void sorts()
+    {
+        for (std::size_t size{0}; size <= N; ++size)
+        {
+            for (int round{0}; round < 20; ++round)
+            {
+                ksv::static_vector<T, N> vec;
+                for (std::size_t i{0}; i < size; ++i)
+                {
+                    if constexpr (std::is_same_v<T, std::string>)
+                        vec.push_back(std::string(static_cast<std::size_t>(kds_test::random(0, 3)), 'x') + std::to_string(kds_test::random(0, 9)));
+                    else
+                        vec.push_back(static_cast<T>(kds_test::random(-20, 20)));
+                }
+                if (round % 4 == 1)
+                    std::ranges::sort(vec);
+                else if (round % 4 == 2)
+                    std::ranges::sort(vec, std::greater<>{});
+
+                auto expected{vec};
+                std::ranges::sort(expected);
+                ksv::sort(vec);
+                KDS_CHECK(vec == expected);
+
+                std::ranges::sort(expected, std::greater<>{});
+                ksv::sort(vec, std::greater<>{});
+                KDS_CHECK(vec == expected);
+            }
+        }
+    }
+
+}// namespace
+
+int main()
+{
+    searches<std::int8_t, 70>();
+    searches<std::uint8_t, 31>();
+    searches<std::int16_t, 40>();
+    searches<std::uint32_t, 13>();
+    searches<std::int32_t, 64>();
+    searches<std::int64_t, 9>();
+    searches<std::uint64_t, 33>();
+    searches<float, 50>();
+    searches<double, 17>();
+    searches<long double, 12>();
+
+    sorts<int, 64>();
+    sorts<int, 5>();
+    sorts<int, 17>();
+    sorts<std::uint8_t, 33>();
+    sorts<double, 64>();
+    sorts<float, 8>();
+    sorts<std::string, 40>();
+}
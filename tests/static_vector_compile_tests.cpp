@@ -0,0 +1,131 @@
+// Compile-time checks of static_vector, building this file is the test.
+
+#include "static_soa_vector.h"
+#include "static_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace
+{
+
+    // footprint, the size type is the narrowest holding N and only fills alignment padding
+
+    static_assert(sizeof(ksv::static_vector<std::uint8_t, 15>) == 16);
+    static_assert(sizeof(ksv::static_vector<std::uint8_t, 63>) == 64);
+    static_assert(sizeof(ksv::static_vector<std::uint8_t, 255>) == 256);
+    static_assert(sizeof(ksv::static_vector<char, 1000>) == 1002);
+    static_assert(sizeof(ksv::static_vector<std::uint16_t, 7>) == 16);
+    static_assert(sizeof(ksv::static_vector<std::uint32_t, 15>) == 64);
+    static_assert(sizeof(ksv::static_vector<std::uint64_t, 7>) == 64);
+    static_assert(sizeof(ksv::static_vector<std::string, 4>) == 4 * sizeof(std::string) + alignof(std::string));
+
+    // constant evaluation
+
+    struct op
+    {
+        std::uint8_t code;
+        std::string_view name;
+    };
+
+    struct defaulted
+    {
+        int value{7};
+    };
+
+    struct no_default
+    {
+        constexpr explicit no_default(int v) : value(v) {}
+
+        int value;
+    };
+
+    consteval ksv::static_vector<op, 8> make_ops()
+    {
+        ksv::static_vector<op, 8> ops;
+        ops.push_back({0x01, "load"});
+        ops.push_back({0x02, "store"});
+        ops.emplace_back(std::uint8_t{0x03}, "jump");
+        return ops;
+    }
+
+    constexpr auto ops{make_ops()};
+    static_assert(ops.size() == 3);
+    static_assert(ops[1].code == 0x02 && ops[1].name == "store");
+    static_assert(ops.back().name == "jump");
+
+    constexpr int sum_codes()
+    {
+        int sum{0};
+        for (const op &entry : ops)
+            sum += entry.code;
+        return sum;
+    }
+
+    static_assert(sum_codes() == 6);
+
+    constexpr ksv::static_vector<int, 4> ints{1, 2, 3};
+    static_assert(ints.size() == 3 && ints[2] == 3);
+    static_assert(ints == ksv::static_vector<int, 4>{1, 2, 3});
+    static_assert(ints < ksv::static_vector<int, 4>{1, 2, 4});
+    static_assert((ints <=> ksv::static_vector<int, 4>{1, 2}) > 0);
+
+    constexpr ksv::static_vector deduced{1, 2, 3};
+    static_assert(std::is_same_v<decltype(deduced), const ksv::static_vector<int, 3>>);
+    static_assert(deduced == ksv::static_vector<int, 3>{1, 2, 3});
+
+    constexpr ksv::static_vector<defaulted, 4> defaults(2, defaulted{});
+    static_assert(defaults.size() == 2 && defaults[1].value == 7);
+
+    consteval int mutate()
+    {
+        ksv::static_vector<int, 8> v{5, 1, 4};
+        v.insert(v.begin() + 1, {2, 3});
+        v.erase(v.begin());
+        v.resize(5, 9);
+        ksv::static_vector<int, 8> other{7};
+        swap(v, other);
+        other.pop_back();
+        return other[0] * 1000 + other[3] * 100 + static_cast<int>(other.size()) * 10 + v[0];
+    }
+
+    static_assert(mutate() == 2447);
+
+    consteval int overwrite()
+    {
+        ksv::static_vector<int, 8> v{1, 2};
+        v.resize_and_overwrite(6, [](int *out, std::size_t count) {
+            for (std::size_t i{2}; i < count; ++i)
+                out[i] = static_cast<int>(i * 10);
+            return count - 1;
+        });
+        return static_cast<int>(v.size()) * 100 + v[1] + v[4];
+    }
+
+    static_assert(overwrite() == 542);
+
+    consteval int transient()
+    {
+        ksv::static_vector<no_default, 4> v;
+        v.emplace_back(3);
+        v.emplace_back(4);
+        ksv::static_vector<no_default, 4> copy{v};
+        return copy[0].value + copy[1].value;
+    }
+
+    static_assert(transient() == 7);
+
+    // proxy iterators of the containers built on static_vector
+
+    static_assert(std::random_access_iterator<ksv::static_soa_vector<8, int, double>::iterator>);
+    static_assert(std::random_access_iterator<ksv::static_soa_vector<8, int, double>::const_iterator>);
+
+}// namespace
+
+int main()
+{
+}
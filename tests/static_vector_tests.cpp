@@ -0,0 +1,361 @@
+// Runtime checks of static_vector against std::vector on randomized operations.
+
+#include "static_vector.h"
+#include "test_support.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+    template<typename T>
+    T make_value(int v)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::string(static_cast<std::size_t>(v % 40), static_cast<char>('a' + v % 26));// crosses the SSO limit
+        else
+            return static_cast<T>(v);
+    }
+
+    template<typename T, std::size_t N>
+    bool same(const ksv::static_vector<T, N> &actual, const std::vector<T> &expected)
+    {
+        return std::ranges::equal(actual, expected);
+    }
+
+    // bulk operations, covering both the memmove path of trivially relocatable
+    // types and the element-wise path of the others
+    template<typename T>
+    void bulk_operations()
+    {
+        constexpr std::size_t capacity{48};
+        ksv::static_vector<T, capacity> actual;
+        std::vector<T> expected;
+
+        for (int step{0}; step < 20000; ++step)
+        {
+            const std::size_t size{expected.size()};
+            const auto pos{kds_test::random<std::size_t>(0, size)};
+            const std::size_t room{capacity - size};
+            const T value{make_value<T>(step)};
+
+            switch (kds_test::random(0, 9))
+            {
+                case 0:
+                    if (room > 0)
+                    {
+                        actual.push_back(value);
+                        expected.push_back(value);
+                    }
+                    break;
+                case 1:
+                    if (room > 0)
+                    {
+                        KDS_CHECK(*actual.insert(actual.begin() + pos, value) == value);
+                        expected.insert(expected.begin() + pos, value);
+                    }
+                    break;
+                case 2:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, std::min<std::size_t>(room, 6))};
+                    actual.insert(actual.begin() + pos, count, value);
+                    expected.insert(expected.begin() + pos, count, value);
+                    break;
+                }
+                case 3:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, std::min<std::size_t>(room, 6))};
+                    std::vector<T> source;
+                    for (std::size_t i{0}; i < count; ++i)
+                        source.push_back(make_value<T>(step + static_cast<int>(i)));
+                    actual.insert(actual.begin() + pos, source.begin(), source.end());
+                    expected.insert(expected.begin() + pos, source.begin(), source.end());
+                    break;
+                }
+                case 4:
+                    if (pos < size)
+                    {
+                        actual.erase(actual.begin() + pos);
+                        expected.erase(expected.begin() + pos);
+                    }
+                    break;
+                case 5:
+                {
+                    const auto last{kds_test::random<std::size_t>(pos, size)};
+                    const auto iter{actual.erase(actual.begin() + pos, actual.begin() + last)};
+                    KDS_CHECK(iter == actual.begin() + pos);
+                    expected.erase(expected.begin() + pos, expected.begin() + last);
+                    break;
+                }
+                case 6:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, capacity)};
+                    actual.resize(count, value);
+                    expected.resize(count, value);
+                    break;
+                }
+                case 7:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, capacity)};
+                    actual.resize(count);
+                    expected.resize(count);
+                    break;
+                }
+                case 8:
+                {
+                    const auto count{kds_test::random<std::size_t>(0, capacity)};
+                    actual.assign(count, value);
+                    expected.assign(count, value);
+                    break;
+                }
+                case 9:
+                    if (size > 0)
+                    {
+                        actual.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+            }
+            KDS_CHECK(same(actual, expected));
+        }
+    }
+
+    void capacity_errors()
+    {
+        ksv::static_vector<int, 4> v{1, 2, 3, 4};
+        KDS_CHECK_THROWS(std::exception, v.push_back(5));
+        KDS_CHECK_THROWS(std::exception, v.insert(v.begin(), 2, 0));
+        KDS_CHECK_THROWS(std::exception, v.resize(5));
+        KDS_CHECK_THROWS(std::out_of_range, v.at(4));
+        KDS_CHECK(v == (ksv::static_vector<int, 4>{1, 2, 3, 4}));
+    }
+
+    void non_throwing_api()
+    {
+        ksv::static_vector<std::string, 3> v;
+        KDS_CHECK(*v.try_push_back("a") == "a");
+        const std::string b{"b"};
+        KDS_CHECK(*v.try_push_back(b) == "b");
+        KDS_CHECK(*v.try_emplace_back(2, 'c') == "cc");
+        KDS_CHECK(v.try_push_back("d") == nullptr);
+        KDS_CHECK(v.try_emplace_back() == nullptr);
+        KDS_CHECK(v.size() == 3);
+
+        ksv::static_vector<int, 5> ints{1, 2};
+        const std::vector<int> source{3, 4, 5, 6, 7};
+        const auto rest{ints.try_append_range(source)};
+        KDS_CHECK(rest == source.begin() + 3);
+        KDS_CHECK(ints == (ksv::static_vector<int, 5>{1, 2, 3, 4, 5}));
+        KDS_CHECK(ints.try_append_range(source) == source.begin());
+
+        ksv::static_vector<int, 4> unchecked;
+        unchecked.unchecked_push_back(1);
+        const int two{2};
+        unchecked.unchecked_push_back(two);
+        KDS_CHECK(unchecked.unchecked_emplace_back(3) == 3);
+        KDS_CHECK(&unchecked.unchecked_emplace_back(4) == &unchecked.back());
+        KDS_CHECK(unchecked == (ksv::static_vector<int, 4>{1, 2, 3, 4}));
+    }
+
+    // a copy throwing partway leaves the vector as it was
+    void exception_rollback()
+    {
+        using kds_test::tracked;
+        using vector = ksv::static_vector<tracked, 16>;
+        {
+            const vector source{1, 2, 3, 4, 5};
+            const int live{tracked::live};
+
+            tracked::copies_until_throw = 2;
+            KDS_CHECK_THROWS(std::runtime_error, vector copy{source});
+            KDS_CHECK(tracked::live == live);
+
+            vector v{7, 8};
+            const std::vector<tracked> expected(v.begin(), v.end());
+            tracked::copies_until_throw = 3;
+            KDS_CHECK_THROWS(std::runtime_error, v.append_range(source));
+            KDS_CHECK(std::ranges::equal(v, expected));
+
+            tracked::copies_until_throw = 1;
+            KDS_CHECK_THROWS(std::runtime_error, v.insert(v.begin(), 4, tracked{9}));
+            KDS_CHECK(std::ranges::equal(v, expected));
+
+            tracked::copies_until_throw = 2;
+            KDS_CHECK_THROWS(std::runtime_error, v.resize(10, tracked{9}));
+            KDS_CHECK(std::ranges::equal(v, expected));
+
+            tracked::copies_until_throw = 4;
+            KDS_CHECK_THROWS(std::runtime_error, vector{source.begin(), source.end()});
+        }
+        KDS_CHECK(tracked::live == 0);
+    }
+
+    // single-pass and unsized sources are read once, sized ones are counted first
+    void range_construction()
+    {
+        std::istringstream stream{"3 1 4 1 5 9 2 6"};
+        const ksv::static_vector<int, 8> from_stream{std::istream_iterator<int>{stream}, std::istream_iterator<int>{}};
+        KDS_CHECK(from_stream == (ksv::static_vector<int, 8>{3, 1, 4, 1, 5, 9, 2, 6}));
+
+        std::istringstream overflow{"1 2 3 4 5"};
+        KDS_CHECK_THROWS(std::exception, ksv::static_vector<int, 4>(std::istream_iterator<int>{overflow}, std::istream_iterator<int>{}));
+
+        for (int round{0}; round < 200; ++round)
+        {
+            std::vector<std::string> source;
+            const auto count{kds_test::random<std::size_t>(0, 32)};
+            for (std::size_t i{0}; i < count; ++i)
+                source.push_back(make_value<std::string>(kds_test::random(0, 1000)));
+
+            const ksv::static_vector<std::string, 32> sized(ksv::from_range, source);
+            KDS_CHECK(same(sized, source));
+
+            auto odd_length{source | std::views::filter([](const std::string &s) { return s.size() % 2 == 1; })};
+            const ksv::static_vector<std::string, 32> unsized(ksv::from_range, odd_length);
+            KDS_CHECK(std::ranges::equal(unsized, odd_length));
+
+            std::list<std::string> list(source.begin(), source.end());
+            ksv::static_vector<std::string, 32> assigned{"x"};
+            assigned.assign(list.begin(), list.end());
+            KDS_CHECK(same(assigned, source));
+            assigned.assign_range(odd_length);
+            KDS_CHECK(std::ranges::equal(assigned, odd_length));
+        }
+    }
+
+    std::vector<int> pointees(const auto &pointers)
+    {
+        std::vector<int> values;
+        for (const auto &p : pointers)
+            values.push_back(*p);
+        return values;
+    }
+
+    // unique_ptr is relocated with memmove on insert, erase and moves, a wrong
+    // byte copy shows up as a double free or leak under the sanitizers
+    void relocation()
+    {
+        static_assert(ksv::is_trivially_relocatable_v<std::unique_ptr<int>>);
+        using vector = ksv::static_vector<std::unique_ptr<int>, 32>;
+        vector actual;
+        std::vector<int> expected;
+
+        for (int step{0}; step < 5000; ++step)
+        {
+            const std::size_t size{expected.size()};
+            const auto pos{kds_test::random<std::size_t>(0, size)};
+            switch (kds_test::random(0, 4))
+            {
+                case 0:
+                case 1:
+                    if (size < actual.capacity())
+                    {
+                        actual.emplace(actual.begin() + pos, std::make_unique<int>(step));
+                        expected.insert(expected.begin() + pos, step);
+                    }
+                    break;
+                case 2:
+                    if (pos < size)
+                    {
+                        actual.erase(actual.begin() + pos);
+                        expected.erase(expected.begin() + pos);
+                    }
+                    break;
+                case 3:
+                {
+                    vector moved{std::move(actual)};
+                    KDS_CHECK(actual.empty());
+                    actual = std::move(moved);
+                    KDS_CHECK(moved.empty());
+                    break;
+                }
+                case 4:
+                {
+                    ksv::static_vector<std::unique_ptr<int>, 64> wider{std::move(actual)};
+                    KDS_CHECK(actual.empty());
+                    while (!wider.empty())
+                    {
+                        actual.insert(actual.begin(), std::move(wider.back()));
+                        wider.pop_back();
+                    }
+                    break;
+                }
+            }
+            KDS_CHECK(pointees(actual) == expected);
+        }
+    }
+
+    // swapping vectors of different lengths exchanges the common prefix and
+    // moves the surplus, for types relocated as bytes and for others
+    template<typename T>
+    void uneven_swap()
+    {
+        for (int round{0}; round < 500; ++round)
+        {
+            ksv::static_vector<T, 24> lhs;
+            ksv::static_vector<T, 24> rhs;
+            lhs.resize(kds_test::random<std::size_t>(0, 24), make_value<T>(round));
+            rhs.resize(kds_test::random<std::size_t>(0, 24), make_value<T>(round + 1));
+            const std::vector<T> old_lhs(lhs.begin(), lhs.end());
+            const std::vector<T> old_rhs(rhs.begin(), rhs.end());
+            swap(lhs, rhs);
+            KDS_CHECK(same(lhs, old_rhs) && same(rhs, old_lhs));
+        }
+    }
+
+    // the bytewise fast paths must agree with std::vector's element order,
+    // small value ranges make long common prefixes likely, wide ones wrap
+    // int8_t around to negative values
+    template<typename T>
+    void comparisons()
+    {
+        for (int round{0}; round < 5000; ++round)
+        {
+            std::vector<T> lhs(kds_test::random<std::size_t>(0, 40));
+            std::vector<T> rhs(kds_test::random<std::size_t>(0, 40));
+            const int spread{round % 2 == 0 ? 2 : 400};
+            for (T &value : lhs)
+                value = make_value<T>(kds_test::random(0, spread));
+            for (T &value : rhs)
+                value = make_value<T>(kds_test::random(0, spread));
+            if (round % 3 == 0)
+                rhs.assign(lhs.begin(), lhs.begin() + static_cast<std::ptrdiff_t>(std::min(lhs.size(), rhs.size())));
+
+            const ksv::static_vector<T, 40> actual_lhs(lhs.begin(), lhs.end());
+            const ksv::static_vector<T, 40> actual_rhs(rhs.begin(), rhs.end());
+            KDS_CHECK((actual_lhs == actual_rhs) == (lhs == rhs));
+            KDS_CHECK((actual_lhs <=> actual_rhs) == (lhs <=> rhs));
+            KDS_CHECK((actual_lhs < actual_rhs) == (lhs < rhs));
+            KDS_CHECK((actual_lhs >= actual_rhs) == (lhs >= rhs));
+        }
+    }
+
+}// namespace
+
+int main()
+{
+    bulk_operations<int>();
+    bulk_operations<std::string>();
+    capacity_errors();
+    non_throwing_api();
+    exception_rollback();
+    range_construction();
+    relocation();
+    uneven_swap<int>();
+    uneven_swap<std::string>();
+    comparisons<std::int8_t>();
+    comparisons<std::uint32_t>();
+    comparisons<std::int64_t>();
+    comparisons<double>();
+    comparisons<std::string>();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// Helpers shared by the runtime tests, each test is an executable that
+// returns normally on success and aborts on the first failed check.
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+
+// unlike assert, stays active in release builds
+#define KDS_CHECK(...)                                                              \
+    do                                                                              \
+    {                                                                               \
+        if (!(__VA_ARGS__))                                                         \
+        {                                                                           \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #__VA_ARGS__); \
+            std::abort();                                                           \
+        }                                                                           \
+    } while (false)
+
+// checks that the expression throws the given exception type
+#define KDS_CHECK_THROWS(exception, ...)                                            \
+    do                                                                              \
+    {                                                                               \
+        bool thrown{false};                                                         \
+        try                                                                         \
+        {                                                                           \
+            __VA_ARGS__;                                                            \
+        }                                                                           \
+        catch (const exception &)                                                   \
+        {                                                                           \
+            thrown = true;                                                          \
+        }                                                                           \
+        KDS_CHECK(thrown);                                                          \
+    } while (false)
+
+namespace kds_test
+{
+
+    // fixed seed, a failure reproduces on every run
+    inline std::mt19937_64 &rng()
+    {
+        static std::mt19937_64 engine{0x6b6473};
+        return engine;
+    }
+
+    // uniform in [low, high]
+    template<typename T>
+    T random(T low, T high)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+            return std::uniform_real_distribution<T>{low, high}(rng());
+        else
+            return static_cast<T>(std::uniform_int_distribution<long long>{static_cast<long long>(low), static_cast<long long>(high)}(rng()));
+    }
+
+    // element that counts live objects and throws from its copy constructor
+    // once a countdown runs out, for checking exception rollback, the
+    // countdown disarms itself after throwing
+    struct tracked
+    {
+        static inline int live{0};
+        static inline int copies_until_throw{-1};
+
+        tracked(int v = 0) : value(v) { ++live; }
+
+        tracked(const tracked &other) : value(other.value)
+        {
+            if (copies_until_throw == 0)
+            {
+                copies_until_throw = -1;
+                throw std::runtime_error("copy failed");
+            }
+            if (copies_until_throw > 0)
+                --copies_until_throw;
+            ++live;
+        }
+
+        tracked(tracked &&other) noexcept : value(other.value) { ++live; }
+
+        tracked &operator=(const tracked &other) = default;
+
+        tracked &operator=(tracked &&other) noexcept = default;
+
+        ~tracked() { --live; }
+
+        friend bool operator==(const tracked &lhs, const tracked &rhs) { return lhs.value == rhs.value; }
+
+        int value;
+    };
+
+}// namespace kds_test